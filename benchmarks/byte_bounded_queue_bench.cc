@@ -0,0 +1,108 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iterator>
+#include <thread>
+#include <vector>
+#include "memory_units_queue.hpp"
+
+using namespace mu::literals;
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    struct message {
+        std::uint64_t payload_size;
+        std::uint64_t sequence;
+    };
+
+    struct message_size {
+        mu::bytes operator()(const message &m) const { return mu::bytes(m.payload_size); }
+    };
+
+    using queue_type = mu::byte_bounded_queue<message, message_size>;
+
+    // Every producer pushes its share of the messages, in batches when batch_size > 1, and every consumer pops until
+    // all the messages have been received. Returns millions of messages per second.
+    double run(const unsigned producers, const unsigned consumers, const std::size_t batch_size)
+    {
+        constexpr std::uint64_t total{2000000};
+        queue_type queue(4_MiB, 1 << 14);
+        std::atomic<std::uint64_t> received{0};
+        std::atomic<bool> go{false};
+        std::vector<std::thread> threads;
+        for (unsigned p{0}; p < producers; ++p)
+            threads.emplace_back([&, p]() {
+                std::vector<message> batch;
+                while (!go.load())
+                    std::this_thread::yield();
+                const auto share{total / producers + (p < total % producers ? 1 : 0)};
+                for (std::uint64_t i{0}; i < share;) {
+                    batch.clear();
+                    for (; batch.size() < batch_size && i < share; ++i)
+                        batch.push_back(message{64 + (i % 16) * 256, i});
+                    if (batch_size == 1) {
+                        queue.push(batch.front());
+                        continue;
+                    }
+                    for (auto first{batch.begin()}; first != batch.end();) {
+                        const auto next{queue.try_push_batch(first, batch.end())};
+                        if (next == first)
+                            std::this_thread::yield();
+                        first = next;
+                    }
+                }
+            });
+        for (unsigned c{0}; c < consumers; ++c)
+            threads.emplace_back([&]() {
+                std::vector<message> batch;
+                while (!go.load())
+                    std::this_thread::yield();
+                while (received.load(std::memory_order_relaxed) < total) {
+                    batch.clear();
+                    const auto popped{queue.try_pop_batch(std::back_inserter(batch), batch_size)};
+                    if (popped == 0)
+                        std::this_thread::yield();
+                    received.fetch_add(popped, std::memory_order_relaxed);
+                }
+            });
+        const auto start{clock_type::now()};
+        go = true;
+        for (auto &thread : threads)
+            thread.join();
+        const auto seconds{std::chrono::duration<double>(clock_type::now() - start).count()};
+        return static_cast<double>(total) / seconds / 1e6;
+    }
+} // namespace
+
+int main()
+{
+    const auto max_threads{std::max(4u, std::thread::hardware_concurrency() / 2)};
+    std::printf("producers x consumers | single (Mmsg/s) | batch of 32 (Mmsg/s)\n");
+    for (unsigned producers{1}; producers <= max_threads; producers *= 2)
+        for (unsigned consumers{1}; consumers <= max_threads; consumers *= 2)
+            std::printf("%9u x %-9u | %15.2f | %20.2f\n", producers, consumers, run(producers, consumers, 1),
+                        run(producers, consumers, 32));
+    return 0;
+}
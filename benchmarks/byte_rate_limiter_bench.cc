@@ -0,0 +1,104 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "memory_units_rate_limiter.hpp"
+
+using namespace mu::literals;
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    // The baseline: a classic token bucket refilled from the elapsed time, under a mutex.
+    class mutex_token_bucket {
+    public:
+        mutex_token_bucket(const double bytes_per_second, const double burst) :
+            bytes_per_second(bytes_per_second), burst(burst), tokens(burst), last(clock_type::now())
+        {
+        }
+
+        bool try_acquire(const mu::bytes size)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            const auto now{clock_type::now()};
+            tokens = std::min(burst, tokens + std::chrono::duration<double>(now - last).count() * bytes_per_second);
+            last = now;
+            const auto amount{static_cast<double>(size.count())};
+            if (tokens < amount)
+                return false;
+            tokens -= amount;
+            return true;
+        }
+
+    private:
+        const double bytes_per_second;
+        const double burst;
+        double tokens;
+        clock_type::time_point last;
+        std::mutex mutex;
+    };
+
+    // Millions of acquisitions per second; the rate is high enough for almost every acquisition to succeed, so
+    // that the cost of the limiter itself is measured.
+    template<typename Limiter>
+    double run(Limiter &limiter, const unsigned thread_count, const std::size_t acquisitions_per_thread)
+    {
+        std::vector<std::thread> threads;
+        std::atomic<bool> go{false};
+        for (unsigned t{0}; t < thread_count; ++t)
+            threads.emplace_back([&limiter, &go, acquisitions_per_thread]() {
+                while (!go.load())
+                    std::this_thread::yield();
+                for (std::size_t i{0}; i < acquisitions_per_thread; ++i)
+                    limiter.try_acquire(64_B);
+            });
+        const auto start{clock_type::now()};
+        go = true;
+        for (auto &thread : threads)
+            thread.join();
+        const auto seconds{std::chrono::duration<double>(clock_type::now() - start).count()};
+        return static_cast<double>(thread_count * acquisitions_per_thread) / seconds / 1e6;
+    }
+} // namespace
+
+int main()
+{
+    constexpr std::size_t acquisitions{2000000};
+    const auto rate{mu::gibibytes_per_second(1024)};
+    const auto max_threads{std::max(8u, std::thread::hardware_concurrency())};
+    std::printf("threads | mutex bucket | gcra | gcra + credits (M acquisitions/s)\n");
+    for (unsigned threads{1}; threads <= max_threads; threads *= 2) {
+        mutex_token_bucket baseline(mu::rate_cast<mu::f_bytes_per_second>(rate).count(), 64.0 * 1024 * 1024);
+        mu::byte_rate_limiter gcra(rate, 64_MiB, 0_B);
+        mu::byte_rate_limiter cached(rate, 64_MiB);
+        const auto baseline_rate{run(baseline, threads, acquisitions)};
+        const auto gcra_rate{run(gcra, threads, acquisitions)};
+        const auto cached_rate{run(cached, threads, acquisitions)};
+        std::printf("%7u | %12.2f | %4.2f | %14.2f\n", threads, baseline_rate, gcra_rate, cached_rate);
+    }
+    return 0;
+}
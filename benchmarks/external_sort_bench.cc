@@ -0,0 +1,72 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "memory_units_external_sort.hpp"
+
+using namespace mu::literals;
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    template<typename Function>
+    double seconds_of(Function function)
+    {
+        const auto start{clock_type::now()};
+        function();
+        return std::chrono::duration<double>(clock_type::now() - start).count();
+    }
+} // namespace
+
+// Usage: external_sort_bench [dataset size in MiB] [temporary directory]
+int main(int argc, char **argv)
+{
+    const mu::mebibytes dataset(argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 512);
+    const auto directory{argc > 2 ? argv[2] : "/tmp"};
+    const auto count{static_cast<std::size_t>(mu::memory_size_cast<mu::bytes>(dataset).count() / 8)};
+    std::vector<std::uint64_t> values(count);
+    std::mt19937_64 engine(42);
+    std::generate(values.begin(), values.end(), [&]() { return engine(); });
+    std::vector<std::uint64_t> sorted(count);
+
+    const auto baseline{seconds_of([&]() {
+        std::copy(values.begin(), values.end(), sorted.begin());
+        std::sort(sorted.begin(), sorted.end());
+    })};
+    std::printf("%llu MiB of 64 bits keys\n", static_cast<unsigned long long>(dataset.count()));
+    std::printf("%-24s | %8.2f s | %7.1f MiB/s\n", "std::sort (in memory)", baseline,
+                static_cast<double>(dataset.count()) / baseline);
+    for (const mu::mebibytes budget : {64_MiB, 256_MiB, 1024_MiB, 4096_MiB}) {
+        const auto elapsed{seconds_of(
+                [&]() { mu::external_sort(values.begin(), values.end(), sorted.begin(), budget, directory); })};
+        if (!std::is_sorted(sorted.begin(), sorted.end()))
+            return EXIT_FAILURE;
+        std::printf("external_sort %6llu MiB | %8.2f s | %7.1f MiB/s\n",
+                    static_cast<unsigned long long>(budget.count()), elapsed,
+                    static_cast<double>(dataset.count()) / elapsed);
+    }
+    return EXIT_SUCCESS;
+}
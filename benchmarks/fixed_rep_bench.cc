@@ -0,0 +1,115 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <vector>
+#include "memory_units_fixed.hpp"
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+    using billing = mu::fixed<48, 16>;
+
+    template<typename Rep>
+    using gigabytes_of = mu::memory_size<Rep, mu::details::gb>;
+
+    template<typename Rep>
+    using megabytes_of = mu::memory_size<Rep, mu::details::mb>;
+
+    // Billing figures are given in ten-thousandths of a gigabyte.
+    template<typename Rep>
+    Rep from_figure(const std::int64_t figure)
+    {
+        return static_cast<Rep>(figure) / static_cast<Rep>(10000);
+    }
+
+    template<>
+    billing from_figure<billing>(const std::int64_t figure)
+    {
+        return billing(static_cast<double>(figure) / 10000);
+    }
+
+    struct result {
+        double sum_ns;
+        double convert_ns;
+        double drift;
+    };
+
+    // Nanoseconds per element to sum the figures and to convert them to megabytes, and the difference between
+    // the sums in the forward and in the reverse order, in bytes.
+    template<typename Rep>
+    result run(const std::vector<std::int64_t> &raw, const unsigned rounds)
+    {
+        std::vector<gigabytes_of<Rep>> figures;
+        figures.reserve(raw.size());
+        for (const auto value : raw)
+            figures.emplace_back(from_figure<Rep>(value));
+        std::vector<megabytes_of<Rep>> converted(figures.size());
+
+        auto sum{gigabytes_of<Rep>::zero()};
+        auto start{clock_type::now()};
+        for (unsigned round{0}; round < rounds; ++round)
+            sum = std::accumulate(figures.cbegin(), figures.cend(), sum);
+        const auto sum_time{clock_type::now() - start};
+
+        start = clock_type::now();
+        for (unsigned round{0}; round < rounds; ++round)
+            std::transform(figures.cbegin(), figures.cend(), converted.begin(), [](const gigabytes_of<Rep> &size) {
+                return mu::memory_size_cast<megabytes_of<Rep>>(size);
+            });
+        const auto convert_time{clock_type::now() - start};
+
+        const auto forward{std::accumulate(figures.cbegin(), figures.cend(), gigabytes_of<Rep>::zero())};
+        const auto backward{std::accumulate(figures.crbegin(), figures.crend(), gigabytes_of<Rep>::zero())};
+        const auto drift{mu::memory_size_cast<mu::memory_size<long double>>(forward - backward).count()};
+        const auto elements{static_cast<double>(figures.size()) * rounds};
+        volatile auto sink{static_cast<double>(sum.count()) + static_cast<double>(converted.back().count())};
+        static_cast<void>(sink);
+        return {std::chrono::duration<double, std::nano>(sum_time).count() / elements,
+                std::chrono::duration<double, std::nano>(convert_time).count() / elements,
+                static_cast<double>(drift < 0 ? -drift : drift)};
+    }
+
+    template<typename Rep>
+    void print(const char *const name, const std::vector<std::int64_t> &raw, const unsigned rounds)
+    {
+        const auto measured{run<Rep>(raw, rounds)};
+        std::printf("%-12s | %8.3f | %12.3f | %14.0f\n", name, measured.sum_ns, measured.convert_ns, measured.drift);
+    }
+} // namespace
+
+int main()
+{
+    constexpr std::size_t figures{1 << 20};
+    constexpr unsigned rounds{20};
+    std::mt19937_64 generator{42};
+    std::vector<std::int64_t> raw(figures);
+    for (auto &value : raw)
+        value = static_cast<std::int64_t>(generator() % 1000000);
+    std::printf("rep          | sum (ns) |  gb->mb (ns) | order drift (B)\n");
+    print<billing>("fixed<48,16>", raw, rounds);
+    print<double>("double", raw, rounds);
+    print<long double>("long double", raw, rounds);
+    return 0;
+}
@@ -0,0 +1,80 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "memory_units_quantile_sketch.hpp"
+
+using namespace mu::literals;
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    double elapsed_seconds(const clock_type::time_point start)
+    {
+        return std::chrono::duration<double>(clock_type::now() - start).count();
+    }
+
+    double relative_error(const mu::bytes estimate, const mu::bytes exact)
+    {
+        return std::abs(static_cast<double>(estimate.count()) - static_cast<double>(exact.count())) /
+               static_cast<double>(exact.count());
+    }
+} // namespace
+
+int main()
+{
+    constexpr std::size_t count{10000000};
+    std::mt19937_64 engine(42);
+    std::lognormal_distribution<double> distribution(8.0, 2.0);
+    std::vector<mu::bytes> sizes;
+    sizes.reserve(count);
+    for (std::size_t i{0}; i < count; ++i)
+        sizes.emplace_back(static_cast<std::uint64_t>(distribution(engine)));
+
+    auto start{clock_type::now()};
+    auto sorted{sizes};
+    std::sort(sorted.begin(), sorted.end(), [](const mu::bytes lhs, const mu::bytes rhs) { return lhs < rhs; });
+    const auto exact_seconds{elapsed_seconds(start)};
+    const auto exact = [&sorted](const double q) {
+        return sorted[static_cast<std::size_t>(q * static_cast<double>(sorted.size() - 1))];
+    };
+    std::printf("exact sort      : %8.1f Mvalues/s, footprint %llu KiB\n", count / exact_seconds / 1e6,
+                static_cast<unsigned long long>(mu::memory_size_cast<mu::kibibytes>(
+                                                        mu::bytes(sorted.capacity() * sizeof(mu::bytes)))
+                                                        .count()));
+
+    for (const auto budget : {mu::kibibytes(8), mu::kibibytes(32), mu::kibibytes(128), mu::kibibytes(512)}) {
+        mu::size_quantile_sketch sketch(budget);
+        start = clock_type::now();
+        sketch.insert(sizes.begin(), sizes.end());
+        const auto p50{sketch.p50()};
+        const auto seconds{elapsed_seconds(start)};
+        std::printf("sketch %4llu KiB : %8.1f Mvalues/s, error p50 %.4f%% p99 %.4f%% p999 %.4f%%\n",
+                    static_cast<unsigned long long>(budget.count()), count / seconds / 1e6,
+                    100 * relative_error(p50, exact(0.5)), 100 * relative_error(sketch.p99(), exact(0.99)),
+                    100 * relative_error(sketch.p999(), exact(0.999)));
+    }
+    return 0;
+}
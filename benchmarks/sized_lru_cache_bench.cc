@@ -0,0 +1,128 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <list>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "memory_units_cache.hpp"
+
+using namespace mu::literals;
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    // The baseline: a single mutex around a map and a recency list, bounded by bytes as well.
+    class mutex_lru_cache {
+    public:
+        explicit mutex_lru_cache(const mu::bytes capacity) : capacity(capacity) {}
+
+        bool get(const std::uint64_t key, std::uint64_t &value)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            const auto it{index.find(key)};
+            if (it == index.end())
+                return false;
+            entries.splice(entries.begin(), entries, it->second);
+            value = it->second->second;
+            return true;
+        }
+
+        void put(const std::uint64_t key, const std::uint64_t value)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            const auto it{index.find(key)};
+            if (it != index.end()) {
+                entries.erase(it->second);
+                index.erase(it);
+                usage -= charge;
+            }
+            while (usage + charge > capacity) {
+                index.erase(entries.back().first);
+                entries.pop_back();
+                usage -= charge;
+            }
+            entries.emplace_front(key, value);
+            index.emplace(key, entries.begin());
+            usage += charge;
+        }
+
+    private:
+        const mu::bytes charge{2 * sizeof(std::uint64_t)};
+        mu::bytes capacity;
+        mu::bytes usage{};
+        std::mutex mutex;
+        std::list<std::pair<std::uint64_t, std::uint64_t>> entries;
+        std::unordered_map<std::uint64_t, std::list<std::pair<std::uint64_t, std::uint64_t>>::iterator> index;
+    };
+
+    template<typename Cache>
+    double run(Cache &cache, const unsigned thread_count, const std::size_t operations_per_thread)
+    {
+        std::vector<std::thread> threads;
+        std::atomic<bool> go{false};
+        for (unsigned t{0}; t < thread_count; ++t)
+            threads.emplace_back([&cache, &go, t, operations_per_thread]() {
+                std::mt19937_64 engine(t);
+                // Skewed key popularity: most lookups hit a small hot set.
+                std::geometric_distribution<std::uint64_t> keys(0.00005);
+                while (!go.load())
+                    std::this_thread::yield();
+                std::uint64_t value{0};
+                for (std::size_t i{0}; i < operations_per_thread; ++i) {
+                    const auto key{keys(engine)};
+                    if (!cache.get(key, value))
+                        cache.put(key, key);
+                }
+            });
+        const auto start{clock_type::now()};
+        go = true;
+        for (auto &thread : threads)
+            thread.join();
+        const auto seconds{std::chrono::duration<double>(clock_type::now() - start).count()};
+        return static_cast<double>(thread_count * operations_per_thread) / seconds / 1e6;
+    }
+} // namespace
+
+int main()
+{
+    constexpr std::size_t operations{2000000};
+    const auto capacity{mu::memory_size_cast<mu::bytes>(256_kiB)};
+    const auto max_threads{std::max(8u, std::thread::hardware_concurrency())};
+    std::printf("threads | mutex map+list | sharded lru | sharded sieve (Mops/s, hit rate)\n");
+    for (unsigned threads{1}; threads <= max_threads; threads *= 2) {
+        mutex_lru_cache baseline(capacity);
+        mu::sized_lru_cache<std::uint64_t, std::uint64_t> lru(capacity, 64, mu::eviction_policy::lru);
+        mu::sized_lru_cache<std::uint64_t, std::uint64_t> sieve(capacity, 64, mu::eviction_policy::sieve);
+        const auto baseline_rate{run(baseline, threads, operations)};
+        const auto lru_rate{run(lru, threads, operations)};
+        const auto sieve_rate{run(sieve, threads, operations)};
+        std::printf("%7u | %14.2f | %6.2f (%.3f) | %6.2f (%.3f)\n", threads, baseline_rate, lru_rate,
+                    lru.statistics().hit_rate(), sieve_rate, sieve.statistics().hit_rate());
+    }
+    return 0;
+}
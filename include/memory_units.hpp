@@ -22,6 +22,7 @@
 #include <cstdint>
 #include <limits>
 #include <ratio>
+#include <stdexcept>
 #include <type_traits>
 
 #define MU_VERSION_MAJOR 1
@@ -46,6 +47,31 @@ namespace mu
         template<typename... Args>
         using common_type_t = typename std::common_type<Args...>::type;
 
+        // Common type of the representations of sizes, std::common_type unless specialized for two representations
+        // std::common_type cannot be specialized for, such as the ones of the standard library.
+        template<typename... Reps>
+        struct rep_common_type : std::common_type<Reps...> {};
+
+        template<typename Rep, typename OtherRep, typename AnotherRep, typename... Reps>
+        struct rep_common_type<Rep, OtherRep, AnotherRep, Reps...>
+            : rep_common_type<typename rep_common_type<Rep, OtherRep>::type, AnotherRep, Reps...> {};
+
+        template<typename... Reps>
+        using rep_common_type_t = typename rep_common_type<Reps...>::type;
+
+        // Conversion of a count between representations, a static_cast unless specialized for representations that
+        // do not convert with it.
+        template<typename To, typename From>
+        struct rep_converter {
+            static constexpr To convert(const From &value) { return static_cast<To>(value); }
+        };
+
+        template<typename To, typename From>
+        constexpr To rep_cast(const From value)
+        {
+            return rep_converter<To, From>::convert(value);
+        }
+
         template<bool Condition>
         struct bool_to_type;
 
@@ -150,9 +176,8 @@ namespace mu
             static constexpr To cast(const memory_size<Rep, Factor> &from)
             {
                 using to_rep = typename To::rep;
-                return To(static_cast<to_rep>(static_cast<CommonRep>(from.count()) *
-                                              static_cast<CommonRep>(CommonFactor::num) /
-                                              static_cast<CommonRep>(CommonFactor::den)));
+                return To(rep_cast<to_rep>(rep_cast<CommonRep>(from.count()) * rep_cast<CommonRep>(CommonFactor::num) /
+                                           rep_cast<CommonRep>(CommonFactor::den)));
             }
         };
 
@@ -162,7 +187,7 @@ namespace mu
             static constexpr To cast(const memory_size<Rep, Factor> &from)
             {
                 using toRep = typename To::rep;
-                return To(static_cast<toRep>(from.count()));
+                return To(rep_cast<toRep>(from.count()));
             }
         };
 
@@ -172,8 +197,7 @@ namespace mu
             static constexpr To cast(const memory_size<Rep, Factor> &from)
             {
                 using to_rep = typename To::rep;
-                return To(static_cast<to_rep>(static_cast<CommonRep>(from.count()) /
-                                              static_cast<CommonRep>(CommonFactor::den)));
+                return To(rep_cast<to_rep>(rep_cast<CommonRep>(from.count()) / rep_cast<CommonRep>(CommonFactor::den)));
             }
         };
 
@@ -183,8 +207,7 @@ namespace mu
             static constexpr To cast(const memory_size<Rep, Factor> &from)
             {
                 using to_rep = typename To::rep;
-                return To(static_cast<to_rep>(static_cast<CommonRep>(from.count()) *
-                                              static_cast<CommonRep>(CommonFactor::num)));
+                return To(rep_cast<to_rep>(rep_cast<CommonRep>(from.count()) * rep_cast<CommonRep>(CommonFactor::num)));
             }
         };
 
@@ -197,7 +220,7 @@ namespace mu
         using to_factor = typename To::factor;
         using to_rep = typename To::rep;
         using common_factor = typename std::ratio_divide<Factor, to_factor>::type;
-        using common_rep = details::common_type_t<to_rep, Rep, std::intmax_t>;
+        using common_rep = details::rep_common_type_t<to_rep, Rep, std::intmax_t>;
         using cast_impl = details::memory_size_cast_impl<To, common_factor, common_rep, common_factor::num == 1,
                                                          common_factor::den == 1>;
         return cast_impl::cast(from);
@@ -359,16 +382,16 @@ namespace mu
 
         template<typename Rep, typename Factor, typename OtherRep, typename OtherFactor>
         struct memory_size_common_type<memory_size<Rep, Factor>, memory_size<OtherRep, OtherFactor>>
-            : memory_size_common_type_impl<typename detect_member_type<std::common_type<Rep, OtherRep>>::type, Factor,
+            : memory_size_common_type_impl<typename detect_member_type<rep_common_type<Rep, OtherRep>>::type, Factor,
                                            OtherFactor>::type {};
 
 
         template<typename Rep, typename OtherRep,
-                 bool = details::is_convertible_v<OtherRep, common_type_t<Rep, OtherRep>>>
+                 bool = details::is_convertible_v<OtherRep, rep_common_type_t<Rep, OtherRep>>>
         struct common_rep_type {};
 
         template<typename Rep, typename AnotherRep>
-        struct common_rep_type<Rep, AnotherRep, true> : identity<common_type_t<Rep, AnotherRep>> {};
+        struct common_rep_type<Rep, AnotherRep, true> : identity<rep_common_type_t<Rep, AnotherRep>> {};
     } // namespace details
 
     template<typename Rep, typename Factor, typename OtherRep, typename OtherFactor>
@@ -490,6 +513,174 @@ namespace mu
         return !(lhs < rhs);
     }
 
+    namespace details
+    {
+        enum class rounding { floor, ceil, nearest_even };
+
+        template<typename Rep, bool = std::is_signed<Rep>::value>
+        struct sign_of {
+            static constexpr Rep is_negative(const Rep value) { return static_cast<Rep>(value < 0); }
+        };
+
+        template<typename Rep>
+        struct sign_of<Rep, false> {
+            static constexpr Rep is_negative(const Rep) { return 0; }
+        };
+
+        template<rounding Mode, typename Rep>
+        constexpr Rep adjusted_quotient(const Rep quotient, const Rep remainder, const Rep divisor)
+        {
+            return Mode == rounding::floor ? quotient
+                   : Mode == rounding::ceil
+                           ? quotient + static_cast<Rep>(remainder != 0)
+                           : quotient + static_cast<Rep>((remainder > divisor - remainder) |
+                                                         ((remainder == divisor - remainder) & (quotient & 1)));
+        }
+
+        template<rounding Mode, typename Rep>
+        constexpr Rep floored_quotient(const Rep dividend, const Rep divisor, const Rep borrow)
+        {
+            return adjusted_quotient<Mode>(dividend / divisor - borrow, dividend % divisor + borrow * divisor, divisor);
+        }
+
+        // Divides and rounds the quotient without branching: the truncated quotient is first brought down to the
+        // floor, leaving a remainder in [0, divisor), then adjusted with the comparisons as integers. With a
+        // divisor known at compile time, the divisions become shifts or multiplications.
+        template<rounding Mode, typename Rep>
+        constexpr Rep rounded_quotient(const Rep dividend, const Rep divisor)
+        {
+            return floored_quotient<Mode>(dividend, divisor, sign_of<Rep>::is_negative(dividend % divisor));
+        }
+
+        template<rounding Mode, typename Whole, typename Value>
+        constexpr Whole adjusted_whole(const Whole lower, const Value fraction)
+        {
+            return Mode == rounding::floor ? lower
+                   : Mode == rounding::ceil
+                           ? lower + static_cast<Whole>(fraction > 0)
+                           : lower + static_cast<Whole>((fraction * 2 > 1) | ((fraction * 2 == 1) & (lower & 1)));
+        }
+
+        template<rounding Mode, typename Whole, typename Value>
+        constexpr Whole rounded_whole(const Value value, const Whole truncated)
+        {
+            return adjusted_whole<Mode>(truncated - static_cast<Whole>(value < static_cast<Value>(truncated)),
+                                        value - static_cast<Value>(truncated -
+                                                                   static_cast<Whole>(value <
+                                                                                      static_cast<Value>(truncated))));
+        }
+
+        // Rounds a floating-point value to a whole number with integer arithmetic, in the widest signed integer for
+        // negative values and the widest unsigned one otherwise, so that the conversion to the representation is
+        // the one of an integral count, wrapping negative values into unsigned representations.
+        template<rounding Mode, typename Rep, typename Value>
+        constexpr Rep rounded_value(const Value value)
+        {
+            return value < 0 ? rep_cast<Rep>(rounded_whole<Mode>(value, static_cast<std::intmax_t>(value)))
+                             : rep_cast<Rep>(rounded_whole<Mode>(value, static_cast<std::uintmax_t>(value)));
+        }
+
+        template<rounding Mode, typename To, typename CommonFactor, typename CommonRep,
+                 bool = std::is_floating_point<typename To::rep>::value, bool = std::is_integral<CommonRep>::value>
+        struct memory_size_round_impl {
+            // Integral to integral: the quotient of the exact value by the denominator of the factor is rounded.
+            template<typename Rep, typename Factor>
+            static constexpr To cast(const memory_size<Rep, Factor> &from)
+            {
+                using to_rep = typename To::rep;
+                return To(rep_cast<to_rep>(rounded_quotient<Mode>(rep_cast<CommonRep>(from.count()) *
+                                                                          rep_cast<CommonRep>(CommonFactor::num),
+                                                                  rep_cast<CommonRep>(CommonFactor::den))));
+            }
+        };
+
+        template<rounding Mode, typename To, typename CommonFactor, typename CommonRep>
+        struct memory_size_round_impl<Mode, To, CommonFactor, CommonRep, false, false> {
+            static_assert(std::is_floating_point<CommonRep>::value, "Only sizes with scalar counts can be rounded");
+
+            // Floating-point to integral: the exact value is computed in the common representation, as by
+            // memory_size_cast, then rounded.
+            template<typename Rep, typename Factor>
+            static constexpr To cast(const memory_size<Rep, Factor> &from)
+            {
+                using to_rep = typename To::rep;
+                return To(rounded_value<Mode, to_rep>(rep_cast<CommonRep>(from.count()) *
+                                                      rep_cast<CommonRep>(CommonFactor::num) /
+                                                      rep_cast<CommonRep>(CommonFactor::den)));
+            }
+        };
+
+        template<rounding Mode, typename To, typename CommonFactor, typename CommonRep, bool Integral>
+        struct memory_size_round_impl<Mode, To, CommonFactor, CommonRep, true, Integral> {
+            // Floating-point targets do not round
+            template<typename Rep, typename Factor>
+            static constexpr To cast(const memory_size<Rep, Factor> &from)
+            {
+                return memory_size_cast<To>(from);
+            }
+        };
+
+        template<rounding Mode, typename To, typename Rep, typename Factor>
+        constexpr Precondition<is_memory_size<To>::value, To> memory_size_round(const memory_size<Rep, Factor> &from)
+        {
+            using common_factor = typename std::ratio_divide<Factor, typename To::factor>::type;
+            using common_rep = rep_common_type_t<typename To::rep, Rep, std::intmax_t>;
+            return memory_size_round_impl<Mode, To, common_factor, common_rep>::cast(from);
+        }
+    } // namespace details
+
+    // Greatest To not greater than the size, e.g. floor<mebibytes>(1536_kiB) == 1_MiB.
+    template<typename To, typename Rep, typename Factor>
+    constexpr details::Precondition<details::is_memory_size<To>::value, To> floor(const memory_size<Rep, Factor> &from)
+    {
+        return details::memory_size_round<details::rounding::floor, To>(from);
+    }
+
+    // Least To not less than the size, e.g. ceil<mebibytes>(1025_kiB) == 2_MiB.
+    template<typename To, typename Rep, typename Factor>
+    constexpr details::Precondition<details::is_memory_size<To>::value, To> ceil(const memory_size<Rep, Factor> &from)
+    {
+        return details::memory_size_round<details::rounding::ceil, To>(from);
+    }
+
+    // Nearest To, halfway cases rounded to the even one, e.g. round<kilobytes>(2500_B) == 2_kB.
+    template<typename To, typename Rep, typename Factor>
+    constexpr details::Precondition<details::is_memory_size<To>::value, To> round(const memory_size<Rep, Factor> &from)
+    {
+        return details::memory_size_round<details::rounding::nearest_even, To>(from);
+    }
+
+    template<typename Rep, typename Factor>
+    constexpr memory_size<Rep, Factor> abs(const memory_size<Rep, Factor> &size)
+    {
+        return details::sign_of<Rep>::is_negative(size.count()) ? -size : size;
+    }
+
+    // Batch variants over ranges, whose loops are free of branches for integral sizes and can be vectorized.
+    template<typename To, typename InputIt, typename OutputIt>
+    OutputIt floor(InputIt first, const InputIt last, OutputIt out)
+    {
+        for (; first != last; ++first, ++out)
+            *out = floor<To>(*first);
+        return out;
+    }
+
+    template<typename To, typename InputIt, typename OutputIt>
+    OutputIt ceil(InputIt first, const InputIt last, OutputIt out)
+    {
+        for (; first != last; ++first, ++out)
+            *out = ceil<To>(*first);
+        return out;
+    }
+
+    template<typename To, typename InputIt, typename OutputIt>
+    OutputIt round(InputIt first, const InputIt last, OutputIt out)
+    {
+        for (; first != last; ++first, ++out)
+            *out = round<To>(*first);
+        return out;
+    }
+
     namespace details
     {
         using b = std::ratio<1>;
@@ -509,6 +700,23 @@ namespace mu
         using tib = std::ratio<1024 * gib::num>;
         using pib = std::ratio<1024 * tib::num>;
         using eib = std::ratio<1024 * pib::num>;
+
+        // Bits, for bandwidths expressed in base 10 or base 2
+        using bit = std::ratio<1, 8>;
+        using kbit = std::ratio_multiply<kb, bit>;
+        using mbit = std::ratio_multiply<mb, bit>;
+        using gbit = std::ratio_multiply<gb, bit>;
+        using tbit = std::ratio_multiply<tb, bit>;
+        using kibit = std::ratio_multiply<kib, bit>;
+        using mibit = std::ratio_multiply<mib, bit>;
+        using gibit = std::ratio_multiply<gib, bit>;
+        using tibit = std::ratio_multiply<tib, bit>;
+
+        // Hardware granularities
+        using sector = std::ratio<512 * b::num>;
+        using cache_line = std::ratio<64 * b::num>;
+        using page = std::ratio<4 * kib::num>;
+        using huge_page = std::ratio<2 * mib::num>;
     } // namespace details
 
     using bytes = memory_size<INT_UNIT_TYPE>;
@@ -543,6 +751,190 @@ namespace mu
     using f_pebibytes = memory_size<FLOAT_UNIT_TYPE, details::pib>;
     using f_exbibytes = memory_size<FLOAT_UNIT_TYPE, details::eib>;
 
+    using bits = memory_size<INT_UNIT_TYPE, details::bit>;
+
+    using kilobits = memory_size<INT_UNIT_TYPE, details::kbit>;
+    using megabits = memory_size<INT_UNIT_TYPE, details::mbit>;
+    using gigabits = memory_size<INT_UNIT_TYPE, details::gbit>;
+    using terabits = memory_size<INT_UNIT_TYPE, details::tbit>;
+
+    using kibibits = memory_size<INT_UNIT_TYPE, details::kibit>;
+    using mebibits = memory_size<INT_UNIT_TYPE, details::mibit>;
+    using gibibits = memory_size<INT_UNIT_TYPE, details::gibit>;
+    using tebibits = memory_size<INT_UNIT_TYPE, details::tibit>;
+
+    using f_bits = memory_size<FLOAT_UNIT_TYPE, details::bit>;
+
+    using f_kilobits = memory_size<FLOAT_UNIT_TYPE, details::kbit>;
+    using f_megabits = memory_size<FLOAT_UNIT_TYPE, details::mbit>;
+    using f_gigabits = memory_size<FLOAT_UNIT_TYPE, details::gbit>;
+    using f_terabits = memory_size<FLOAT_UNIT_TYPE, details::tbit>;
+
+    using f_kibibits = memory_size<FLOAT_UNIT_TYPE, details::kibit>;
+    using f_mebibits = memory_size<FLOAT_UNIT_TYPE, details::mibit>;
+    using f_gibibits = memory_size<FLOAT_UNIT_TYPE, details::gibit>;
+    using f_tebibits = memory_size<FLOAT_UNIT_TYPE, details::tibit>;
+
+    using sectors = memory_size<INT_UNIT_TYPE, details::sector>;
+    using cache_lines = memory_size<INT_UNIT_TYPE, details::cache_line>;
+    using pages = memory_size<INT_UNIT_TYPE, details::page>;
+    using huge_pages = memory_size<INT_UNIT_TYPE, details::huge_page>;
+
+    // A number of objects of type T, e.g. memory_size_cast<elements<float>>(64_MiB) == elements<float>(16777216).
+    // Types of the same size share the same unit.
+    template<typename T, typename Rep = INT_UNIT_TYPE>
+    using elements = memory_size<Rep, std::ratio<sizeof(T)>>;
+
+    namespace details
+    {
+        constexpr bool is_power_of_two(const std::uintmax_t value) { return value != 0 && (value & (value - 1)) == 0; }
+
+        // Both implementations round towards the infinities, negative sizes included: the division rounds towards
+        // zero, so a negative remainder is brought back to the multiple below, as the mask does.
+        template<typename Rep, bool = false>
+        struct align_impl {
+            static constexpr Rep remainder(const Rep value, const Rep alignment)
+            {
+                const auto result{static_cast<Rep>(value % alignment)};
+                return result != 0 && !(result > 0) ? static_cast<Rep>(result + alignment) : result;
+            }
+
+            static constexpr Rep up(const Rep value, const Rep alignment)
+            {
+                const auto offset{remainder(value, alignment)};
+                return offset == 0 ? value : static_cast<Rep>(value - offset + alignment);
+            }
+
+            static constexpr Rep down(const Rep value, const Rep alignment)
+            {
+                return static_cast<Rep>(value - remainder(value, alignment));
+            }
+
+            static constexpr bool aligned(const Rep value, const Rep alignment) { return value % alignment == 0; }
+        };
+
+        template<typename Rep>
+        struct align_impl<Rep, true> {
+            static constexpr Rep up(const Rep value, const Rep alignment)
+            {
+                return (value + alignment - 1) & ~(alignment - 1);
+            }
+
+            static constexpr Rep down(const Rep value, const Rep alignment) { return value & ~(alignment - 1); }
+
+            static constexpr bool aligned(const Rep value, const Rep alignment)
+            {
+                return (value & (alignment - 1)) == 0;
+            }
+        };
+
+        // Expresses a size and a unit in their common type, where the unit is a whole number of counts.
+        template<typename Unit, typename Rep, typename Factor>
+        struct alignment_traits {
+            static_assert(is_memory_size<Unit>::value, "The alignment unit must be a memory_size");
+            static_assert(std::is_integral<Rep>::value, "Only integral sizes can be aligned");
+            using type = typename memory_size_common_type<memory_size<Rep, Factor>,
+                                                          memory_size<typename Unit::rep, typename Unit::factor>>::type;
+            using rep = typename type::rep;
+            static constexpr rep alignment{
+                    static_cast<rep>(std::ratio_divide<typename Unit::factor, typename type::factor>::type::num)};
+            using impl = align_impl<rep, is_power_of_two(alignment)>;
+        };
+
+        template<typename Rep>
+        constexpr Rep checked_alignment(const Rep alignment)
+        {
+            return alignment > 0 ? alignment : throw std::invalid_argument("An alignment must be a positive size");
+        }
+    } // namespace details
+
+    // Rounds a size up to the next multiple of a unit, e.g. align_up<pages>(10_kiB) == 12_kiB. The result is
+    // expressed in the common type of the size and the unit. Units whose size is a power of two of the common
+    // factor are aligned with masks.
+    template<typename Unit, typename Rep, typename Factor>
+    constexpr typename details::alignment_traits<Unit, Rep, Factor>::type
+    align_up(const memory_size<Rep, Factor> &size)
+    {
+        using traits = details::alignment_traits<Unit, Rep, Factor>;
+        return typename traits::type(traits::impl::up(typename traits::type(size).count(), traits::alignment));
+    }
+
+    template<typename Unit, typename Rep, typename Factor>
+    constexpr typename details::alignment_traits<Unit, Rep, Factor>::type
+    align_down(const memory_size<Rep, Factor> &size)
+    {
+        using traits = details::alignment_traits<Unit, Rep, Factor>;
+        return typename traits::type(traits::impl::down(typename traits::type(size).count(), traits::alignment));
+    }
+
+    template<typename Unit, typename Rep, typename Factor>
+    constexpr bool is_aligned(const memory_size<Rep, Factor> &size)
+    {
+        using traits = details::alignment_traits<Unit, Rep, Factor>;
+        return traits::impl::aligned(typename traits::type(size).count(), traits::alignment);
+    }
+
+    // Runtime alignments, such as the page size of the system, are aligned with masks when they are a power of
+    // two, which is checked on every call. An alignment that is not positive throws std::invalid_argument.
+    template<typename Rep, typename Factor, typename OtherRep, typename OtherFactor>
+    constexpr typename details::memory_size_common_type<memory_size<Rep, Factor>,
+                                                        memory_size<OtherRep, OtherFactor>>::type
+    align_up(const memory_size<Rep, Factor> &size, const memory_size<OtherRep, OtherFactor> &alignment)
+    {
+        using common_type = typename details::memory_size_common_type<memory_size<Rep, Factor>,
+                                                                      memory_size<OtherRep, OtherFactor>>::type;
+        using rep = typename common_type::rep;
+        const auto value{common_type(size).count()};
+        const auto unit{details::checked_alignment(common_type(alignment).count())};
+        return common_type(details::is_power_of_two(unit) ? details::align_impl<rep, true>::up(value, unit)
+                                                          : details::align_impl<rep, false>::up(value, unit));
+    }
+
+    template<typename Rep, typename Factor, typename OtherRep, typename OtherFactor>
+    constexpr typename details::memory_size_common_type<memory_size<Rep, Factor>,
+                                                        memory_size<OtherRep, OtherFactor>>::type
+    align_down(const memory_size<Rep, Factor> &size, const memory_size<OtherRep, OtherFactor> &alignment)
+    {
+        using common_type = typename details::memory_size_common_type<memory_size<Rep, Factor>,
+                                                                      memory_size<OtherRep, OtherFactor>>::type;
+        using rep = typename common_type::rep;
+        const auto value{common_type(size).count()};
+        const auto unit{details::checked_alignment(common_type(alignment).count())};
+        return common_type(details::is_power_of_two(unit) ? details::align_impl<rep, true>::down(value, unit)
+                                                          : details::align_impl<rep, false>::down(value, unit));
+    }
+
+    template<typename Rep, typename Factor, typename OtherRep, typename OtherFactor>
+    constexpr bool is_aligned(const memory_size<Rep, Factor> &size, const memory_size<OtherRep, OtherFactor> &alignment)
+    {
+        using common_type = typename details::memory_size_common_type<memory_size<Rep, Factor>,
+                                                                      memory_size<OtherRep, OtherFactor>>::type;
+        using rep = typename common_type::rep;
+        const auto value{common_type(size).count()};
+        const auto unit{details::checked_alignment(common_type(alignment).count())};
+        return details::is_power_of_two(unit) ? details::align_impl<rep, true>::aligned(value, unit)
+                                              : details::align_impl<rep, false>::aligned(value, unit);
+    }
+
+    // Reserves room in a container for as many elements as fit in a memory budget, e.g. reserve_for(samples, 256_MiB),
+    // and returns that number of elements.
+    template<typename Container, typename Rep, typename Factor>
+    elements<typename Container::value_type> reserve_for(Container &container, const memory_size<Rep, Factor> &budget)
+    {
+        const auto capacity{memory_size_cast<elements<typename Container::value_type>>(budget)};
+        container.reserve(static_cast<typename Container::size_type>(capacity.count()));
+        return capacity;
+    }
+
+    // Resizes a container to as many elements as fit in a memory budget and returns that number of elements.
+    template<typename Container, typename Rep, typename Factor>
+    elements<typename Container::value_type> resize_for(Container &container, const memory_size<Rep, Factor> &budget)
+    {
+        const auto count{memory_size_cast<elements<typename Container::value_type>>(budget)};
+        container.resize(static_cast<typename Container::size_type>(count.count()));
+        return count;
+    }
+
 
     namespace literals
     {
@@ -691,10 +1083,10 @@ namespace mu
         constexpr MemorySize construct_if_no_overflow()
         {
             using Value = parse_details::integral_parser<Digits...>;
-            constexpr typename MemorySize::rep value{Value::value};
-            static_assert(value >= 0 && value == Value::value,
+            using rep = typename MemorySize::rep;
+            static_assert(static_cast<rep>(Value::value) >= 0 && static_cast<rep>(Value::value) == Value::value,
                           "Literal value cannot be represented by memory size type");
-            return MemorySize(value);
+            return MemorySize(static_cast<rep>(Value::value));
         }
 
         constexpr memory_size<long double> operator"" _B(const long double bytes)
@@ -840,6 +1232,488 @@ namespace mu
             return construct_if_no_overflow<exbibytes, Digits...>();
         }
 
+        constexpr memory_size<long double, details::bit> operator"" _b(const long double bits)
+        {
+            return memory_size<long double, details::bit>{bits};
+        }
+
+        constexpr memory_size<long double, details::kbit> operator"" _kb(const long double kilobits)
+        {
+            return memory_size<long double, details::kbit>{kilobits};
+        }
+
+        constexpr memory_size<long double, details::mbit> operator"" _Mb(const long double megabits)
+        {
+            return memory_size<long double, details::mbit>{megabits};
+        }
+
+        constexpr memory_size<long double, details::gbit> operator"" _Gb(const long double gigabits)
+        {
+            return memory_size<long double, details::gbit>{gigabits};
+        }
+
+        constexpr memory_size<long double, details::tbit> operator"" _Tb(const long double terabits)
+        {
+            return memory_size<long double, details::tbit>{terabits};
+        }
+
+        constexpr memory_size<long double, details::kibit> operator"" _kib(const long double kibibits)
+        {
+            return memory_size<long double, details::kibit>{kibibits};
+        }
+
+        constexpr memory_size<long double, details::mibit> operator"" _Mib(const long double mebibits)
+        {
+            return memory_size<long double, details::mibit>{mebibits};
+        }
+
+        constexpr memory_size<long double, details::gibit> operator"" _Gib(const long double gibibits)
+        {
+            return memory_size<long double, details::gibit>{gibibits};
+        }
+
+        constexpr memory_size<long double, details::tibit> operator"" _Tib(const long double tebibits)
+        {
+            return memory_size<long double, details::tibit>{tebibits};
+        }
+
+        template<char... Digits>
+        constexpr bits operator""_b()
+        {
+            return construct_if_no_overflow<bits, Digits...>();
+        }
+
+        template<char... Digits>
+        constexpr kilobits operator""_kb()
+        {
+            return construct_if_no_overflow<kilobits, Digits...>();
+        }
+
+        template<char... Digits>
+        constexpr megabits operator""_Mb()
+        {
+            return construct_if_no_overflow<megabits, Digits...>();
+        }
+
+        template<char... Digits>
+        constexpr gigabits operator""_Gb()
+        {
+            return construct_if_no_overflow<gigabits, Digits...>();
+        }
+
+        template<char... Digits>
+        constexpr terabits operator""_Tb()
+        {
+            return construct_if_no_overflow<terabits, Digits...>();
+        }
+
+        template<char... Digits>
+        constexpr kibibits operator""_kib()
+        {
+            return construct_if_no_overflow<kibibits, Digits...>();
+        }
+
+        template<char... Digits>
+        constexpr mebibits operator""_Mib()
+        {
+            return construct_if_no_overflow<mebibits, Digits...>();
+        }
+
+        template<char... Digits>
+        constexpr gibibits operator""_Gib()
+        {
+            return construct_if_no_overflow<gibibits, Digits...>();
+        }
+
+        template<char... Digits>
+        constexpr tebibits operator""_Tib()
+        {
+            return construct_if_no_overflow<tebibits, Digits...>();
+        }
+
+
+        namespace parse_details
+        {
+            enum class decimal_status { exact, fractional, overflow, not_decimal };
+
+            struct decimal_value {
+                unsigned long long value;
+                decimal_status status;
+            };
+
+            // State of the scan of a decimal literal, one character at a time.
+            struct decimal_state {
+                decimal_value mantissa;
+                long long exponent;
+                long long zeros;
+                long long explicit_exponent;
+                bool negative_exponent;
+                bool fraction;
+                bool in_exponent;
+            };
+
+            // Value and remaining count left by dividing a value by a prime up to count times.
+            struct cancelled_factor {
+                unsigned long long value;
+                long long remaining;
+            };
+
+            constexpr cancelled_factor cancel_factor(const unsigned long long value, const unsigned long long prime,
+                                                     const long long count)
+            {
+                return count > 0 && value % prime == 0 ? cancel_factor(value / prime, prime, count - 1)
+                                                       : cancelled_factor{value, count};
+            }
+
+            constexpr decimal_value multiply(const decimal_value value, const unsigned long long factor)
+            {
+                return value.status != decimal_status::exact ? value
+                       : factor != 0 && value.value > std::numeric_limits<unsigned long long>::max() / factor
+                               ? decimal_value{0, decimal_status::overflow}
+                               : decimal_value{value.value * factor, decimal_status::exact};
+            }
+
+            constexpr decimal_value add_digit(const decimal_value value, const unsigned long long digit)
+            {
+                return value.status != decimal_status::exact || value.value + digit >= value.value
+                               ? decimal_value{value.value + digit, value.status}
+                               : decimal_value{0, decimal_status::overflow};
+            }
+
+            constexpr decimal_value multiply_by_ten(const decimal_value value, const long long count)
+            {
+                return count > 0 ? multiply_by_ten(multiply(value, 10), count - 1) : value;
+            }
+
+            constexpr bool has_decimal_mark()
+            {
+                return false;
+            }
+
+            template<typename... Characters>
+            constexpr bool has_decimal_mark(const char character, const Characters... rest)
+            {
+                return character == '.' || character == 'e' || character == 'E' || has_decimal_mark(rest...);
+            }
+
+            template<typename... Characters>
+            constexpr bool has_radix_prefix(const char first, const char second, const Characters...)
+            {
+                return first == '0' && (second == 'x' || second == 'X' || second == 'b' || second == 'B');
+            }
+
+            template<char... Digits>
+            constexpr bool is_decimal_fraction()
+            {
+                return !has_radix_prefix(Digits..., '\0', '\0') && has_decimal_mark(Digits...);
+            }
+
+            // Zeros are only folded into the mantissa once followed by another digit, so that trailing zeros end up
+            // in the exponent instead, where they can be cancelled.
+            constexpr decimal_state scan_character(const decimal_state state, const char character)
+            {
+                return state.mantissa.status != decimal_status::exact || character == '\'' ? state
+                       : character == '.'
+                               ? decimal_state{state.mantissa,          state.exponent, state.zeros,
+                                               state.explicit_exponent, state.negative_exponent,
+                                               true,                    state.in_exponent}
+                       : character == 'e' || character == 'E'
+                               ? decimal_state{state.mantissa,          state.exponent, state.zeros,
+                                               state.explicit_exponent, state.negative_exponent,
+                                               state.fraction,          true}
+                       : state.in_exponent && (character == '-' || character == '+')
+                               ? decimal_state{state.mantissa,          state.exponent, state.zeros,
+                                               state.explicit_exponent, character == '-',
+                                               state.fraction,          state.in_exponent}
+                       : character < '0' || character > '9'
+                               ? decimal_state{{0, decimal_status::not_decimal},
+                                               state.exponent,
+                                               state.zeros,
+                                               state.explicit_exponent,
+                                               state.negative_exponent,
+                                               state.fraction,
+                                               state.in_exponent}
+                       : state.in_exponent
+                               ? decimal_state{state.mantissa,
+                                               state.exponent,
+                                               state.zeros,
+                                               state.explicit_exponent * 10 + (character - '0'),
+                                               state.negative_exponent,
+                                               state.fraction,
+                                               state.in_exponent}
+                       : character == '0'
+                               ? decimal_state{state.mantissa,          state.exponent - (state.fraction ? 1 : 0),
+                                               state.zeros + 1,         state.explicit_exponent,
+                                               state.negative_exponent, state.fraction,
+                                               state.in_exponent}
+                               : decimal_state{add_digit(multiply_by_ten(state.mantissa, state.zeros + 1),
+                                                         static_cast<unsigned long long>(character - '0')),
+                                               state.exponent - (state.fraction ? 1 : 0),
+                                               0,
+                                               state.explicit_exponent,
+                                               state.negative_exponent,
+                                               state.fraction,
+                                               state.in_exponent};
+            }
+
+            template<char... Digits>
+            struct decimal_scanner;
+
+            template<>
+            struct decimal_scanner<> {
+                static constexpr decimal_state scan(const decimal_state state) { return state; }
+            };
+
+            template<char Digit, char... Digits>
+            struct decimal_scanner<Digit, Digits...> {
+                static constexpr decimal_state scan(const decimal_state state)
+                {
+                    return decimal_scanner<Digits...>::scan(scan_character(state, Digit));
+                }
+            };
+
+            constexpr decimal_value settle_decimal(const long long twos, const unsigned long long mantissa,
+                                                   const cancelled_factor numerator_fives,
+                                                   const unsigned long long denominator)
+            {
+                return twos != 0 || numerator_fives.remaining != 0 || denominator != 1
+                               ? decimal_value{0, decimal_status::fractional}
+                               : multiply(decimal_value{mantissa, decimal_status::exact}, numerator_fives.value);
+            }
+
+            constexpr decimal_value cancel_fives(const long long twos, const cancelled_factor mantissa_fives,
+                                                 const unsigned long long numerator,
+                                                 const unsigned long long denominator)
+            {
+                return settle_decimal(twos, mantissa_fives.value,
+                                      cancel_factor(numerator, 5, mantissa_fives.remaining), denominator);
+            }
+
+            constexpr decimal_value cancel_twos(const cancelled_factor mantissa_twos,
+                                                const cancelled_factor numerator_twos, const long long count,
+                                                const unsigned long long denominator)
+            {
+                return cancel_fives(numerator_twos.remaining, cancel_factor(mantissa_twos.value, 5, count),
+                                    numerator_twos.value, denominator);
+            }
+
+            // The powers of ten dividing the digits are cancelled against the digits and the factor one prime at a
+            // time, so that the value is only rejected when it is really not a whole number of base units or does
+            // not fit, and never rounded.
+            constexpr decimal_value finish_decimal(const decimal_value mantissa, const long long exponent,
+                                                   const unsigned long long numerator,
+                                                   const unsigned long long denominator)
+            {
+                return mantissa.status != decimal_status::exact || mantissa.value == 0
+                               ? decimal_value{0, mantissa.status}
+                       : exponent > 0 ? finish_decimal(multiply(mantissa, 10), exponent - 1, numerator, denominator)
+                                      : cancel_twos(cancel_factor(mantissa.value, 2, -exponent),
+                                                    cancel_factor(numerator, 2,
+                                                                  cancel_factor(mantissa.value, 2, -exponent)
+                                                                          .remaining),
+                                                    -exponent, denominator);
+            }
+
+            constexpr decimal_value finish_decimal(const decimal_state state, const unsigned long long numerator,
+                                                   const unsigned long long denominator)
+            {
+                return finish_decimal(state.mantissa,
+                                      state.exponent + state.zeros +
+                                              (state.negative_exponent ? -state.explicit_exponent
+                                                                       : state.explicit_exponent),
+                                      numerator, denominator);
+            }
+
+            // Evaluates a decimal floating literal times a factor as an exact integer.
+            template<char... Digits>
+            constexpr decimal_value parse_decimal(const unsigned long long numerator,
+                                                  const unsigned long long denominator)
+            {
+                return finish_decimal(decimal_scanner<Digits...>::scan(decimal_state{
+                                              {0, decimal_status::exact}, 0, 0, 0, false, false, false}),
+                                      numerator, denominator);
+            }
+        } // namespace parse_details
+
+        // Exact literals, e.g. 1.5_GiB, evaluated at compile time without any floating point arithmetic. Literals
+        // with a fraction or an exponent give the base unit, mu::bytes or mu::bits, and fail to compile unless the
+        // value is a whole number of it. Integer literals give the same types as the mu::literals operators, which
+        // these replace: the two namespaces are mutually exclusive, as using both makes every integer literal
+        // ambiguous and every floating literal resolve to the long double operators.
+        namespace exact
+        {
+            template<typename Unit, typename Base, char... Digits>
+            using exact_literal_t = typename std::conditional<parse_details::is_decimal_fraction<Digits...>(), Base,
+                                                              Unit>::type;
+
+            template<typename Unit, typename Base, char... Digits>
+            constexpr Unit exact_literal_impl(std::false_type)
+            {
+                return construct_if_no_overflow<Unit, Digits...>();
+            }
+
+            template<typename Unit, typename Base, char... Digits>
+            struct exact_decimal {
+                using factor = std::ratio_divide<typename Unit::factor, typename Base::factor>;
+                static constexpr parse_details::decimal_status status{
+                        parse_details::parse_decimal<Digits...>(factor::num, factor::den).status};
+                static constexpr unsigned long long value{
+                        parse_details::parse_decimal<Digits...>(factor::num, factor::den).value};
+                static_assert(status != parse_details::decimal_status::not_decimal,
+                              "Only decimal floating literals can be evaluated exactly");
+                static_assert(status != parse_details::decimal_status::fractional,
+                              "Literal value is not a whole number of the base unit");
+                static_assert(status != parse_details::decimal_status::overflow &&
+                                      value <= std::numeric_limits<typename Base::rep>::max(),
+                              "Literal value cannot be represented by memory size type");
+            };
+
+            template<typename Unit, typename Base, char... Digits>
+            constexpr Base exact_literal_impl(std::true_type)
+            {
+                return Base(static_cast<typename Base::rep>(exact_decimal<Unit, Base, Digits...>::value));
+            }
+
+            template<typename Unit, typename Base, char... Digits>
+            constexpr exact_literal_t<Unit, Base, Digits...> exact_literal()
+            {
+                return exact_literal_impl<Unit, Base, Digits...>(
+                        std::integral_constant<bool, parse_details::is_decimal_fraction<Digits...>()>{});
+            }
+
+            template<char... Digits>
+            constexpr exact_literal_t<bytes, bytes, Digits...> operator""_B()
+            {
+                return exact_literal<bytes, bytes, Digits...>();
+            }
+
+            template<char... Digits>
+            constexpr exact_literal_t<kilobytes, bytes, Digits...> operator""_kB()
+            {
+                return exact_literal<kilobytes, bytes, Digits...>();
+            }
+
+            template<char... Digits>
+            constexpr exact_literal_t<megabytes, bytes, Digits...> operator""_MB()
+            {
+                return exact_literal<megabytes, bytes, Digits...>();
+            }
+
+            template<char... Digits>
+            constexpr exact_literal_t<gigabytes, bytes, Digits...> operator""_GB()
+            {
+                return exact_literal<gigabytes, bytes, Digits...>();
+            }
+
+            template<char... Digits>
+            constexpr exact_literal_t<terabytes, bytes, Digits...> operator""_TB()
+            {
+                return exact_literal<terabytes, bytes, Digits...>();
+            }
+
+            template<char... Digits>
+            constexpr exact_literal_t<petabytes, bytes, Digits...> operator""_PB()
+            {
+                return exact_literal<petabytes, bytes, Digits...>();
+            }
+
+            template<char... Digits>
+            constexpr exact_literal_t<exabytes, bytes, Digits...> operator""_EB()
+            {
+                return exact_literal<exabytes, bytes, Digits...>();
+            }
+
+            template<char... Digits>
+            constexpr exact_literal_t<kibibytes, bytes, Digits...> operator""_kiB()
+            {
+                return exact_literal<kibibytes, bytes, Digits...>();
+            }
+
+            template<char... Digits>
+            constexpr exact_literal_t<mebibytes, bytes, Digits...> operator""_MiB()
+            {
+                return exact_literal<mebibytes, bytes, Digits...>();
+            }
+
+            template<char... Digits>
+            constexpr exact_literal_t<gibibytes, bytes, Digits...> operator""_GiB()
+            {
+                return exact_literal<gibibytes, bytes, Digits...>();
+            }
+
+            template<char... Digits>
+            constexpr exact_literal_t<tebibytes, bytes, Digits...> operator""_TiB()
+            {
+                return exact_literal<tebibytes, bytes, Digits...>();
+            }
+
+            template<char... Digits>
+            constexpr exact_literal_t<pebibytes, bytes, Digits...> operator""_PiB()
+            {
+                return exact_literal<pebibytes, bytes, Digits...>();
+            }
+
+            template<char... Digits>
+            constexpr exact_literal_t<exbibytes, bytes, Digits...> operator""_EiB()
+            {
+                return exact_literal<exbibytes, bytes, Digits...>();
+            }
+
+            template<char... Digits>
+            constexpr exact_literal_t<bits, bits, Digits...> operator""_b()
+            {
+                return exact_literal<bits, bits, Digits...>();
+            }
+
+            template<char... Digits>
+            constexpr exact_literal_t<kilobits, bits, Digits...> operator""_kb()
+            {
+                return exact_literal<kilobits, bits, Digits...>();
+            }
+
+            template<char... Digits>
+            constexpr exact_literal_t<megabits, bits, Digits...> operator""_Mb()
+            {
+                return exact_literal<megabits, bits, Digits...>();
+            }
+
+            template<char... Digits>
+            constexpr exact_literal_t<gigabits, bits, Digits...> operator""_Gb()
+            {
+                return exact_literal<gigabits, bits, Digits...>();
+            }
+
+            template<char... Digits>
+            constexpr exact_literal_t<terabits, bits, Digits...> operator""_Tb()
+            {
+                return exact_literal<terabits, bits, Digits...>();
+            }
+
+            template<char... Digits>
+            constexpr exact_literal_t<kibibits, bits, Digits...> operator""_kib()
+            {
+                return exact_literal<kibibits, bits, Digits...>();
+            }
+
+            template<char... Digits>
+            constexpr exact_literal_t<mebibits, bits, Digits...> operator""_Mib()
+            {
+                return exact_literal<mebibits, bits, Digits...>();
+            }
+
+            template<char... Digits>
+            constexpr exact_literal_t<gibibits, bits, Digits...> operator""_Gib()
+            {
+                return exact_literal<gibibits, bits, Digits...>();
+            }
+
+            template<char... Digits>
+            constexpr exact_literal_t<tebibits, bits, Digits...> operator""_Tib()
+            {
+                return exact_literal<tebibits, bits, Digits...>();
+            }
+        } // namespace exact
+
     } // namespace litterals
 
 
@@ -0,0 +1,300 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#ifndef MEMORY_UNITS_CACHE_HPP
+#define MEMORY_UNITS_CACHE_HPP
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "memory_units.hpp"
+
+namespace mu
+{
+    enum class eviction_policy {
+        lru,  // Exact recency order, every hit moves the entry under an exclusive lock
+        sieve // SIEVE: hits only set a visited bit under a shared lock, so concurrent readers never serialize
+    };
+
+    struct cache_statistics {
+        bytes capacity;
+        bytes usage;
+        std::uint64_t entries;
+        std::uint64_t hits;
+        std::uint64_t misses;
+        std::uint64_t evictions;
+        bytes evicted;
+
+        [[nodiscard]] double hit_rate() const
+        {
+            const auto lookups{hits + misses};
+            return lookups ? static_cast<double>(hits) / static_cast<double>(lookups) : 0.0;
+        }
+    };
+
+    namespace details
+    {
+        struct shallow_charge {
+            template<typename Key, typename Value>
+            constexpr bytes operator()(const Key &, const Value &) const
+            {
+                return bytes(sizeof(Key) + sizeof(Value));
+            }
+        };
+    } // namespace details
+
+    // Cache bounded by the sum of the charges of its entries rather than by their count. The capacity is split
+    // evenly among independently locked shards, so threads working on different keys rarely contend.
+    template<typename Key, typename Value, typename SizeFn = details::shallow_charge, typename Hash = std::hash<Key>>
+    class sized_lru_cache {
+    public:
+        template<typename Rep, typename Factor>
+        explicit sized_lru_cache(const memory_size<Rep, Factor> &capacity, const std::size_t shard_count = 16,
+                                 const eviction_policy policy = eviction_policy::lru, SizeFn size_of = SizeFn(),
+                                 Hash hasher = Hash()) :
+            policy(policy), size_of(std::move(size_of)), hasher(std::move(hasher)),
+            shards(std::max<std::size_t>(shard_count, 1))
+        {
+            const auto total{memory_size_cast<bytes>(capacity)};
+            for (auto &shard : shards)
+                shard.capacity = total / shards.size();
+        }
+
+        // Inserts or replaces an entry, evicting as much as needed. Entries charged more than the capacity of a
+        // shard are rejected.
+        bool put(const Key &key, Value value)
+        {
+            const auto charge{memory_size_cast<bytes>(size_of(key, value))};
+            auto &shard{shard_of(key)};
+            std::unique_lock<std::shared_timed_mutex> lock(shard.mutex);
+            const auto it{shard.index.find(key)};
+            if (it != shard.index.end())
+                shard.erase(it);
+            if (charge > shard.capacity)
+                return false;
+            while (shard.usage + charge > shard.capacity)
+                shard.evict(policy);
+            shard.entries.emplace_front(key, std::move(value), charge);
+            shard.index.emplace(key, shard.entries.begin());
+            shard.usage += charge;
+            return true;
+        }
+
+        bool get(const Key &key, Value &value)
+        {
+            auto &shard{shard_of(key)};
+            if (policy == eviction_policy::sieve) {
+                std::shared_lock<std::shared_timed_mutex> lock(shard.mutex);
+                const auto it{shard.index.find(key)};
+                if (it == shard.index.end())
+                    return shard.miss();
+                it->second->visited.store(true, std::memory_order_relaxed);
+                value = it->second->value;
+                return shard.hit();
+            }
+            std::unique_lock<std::shared_timed_mutex> lock(shard.mutex);
+            const auto it{shard.index.find(key)};
+            if (it == shard.index.end())
+                return shard.miss();
+            shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+            value = it->second->value;
+            return shard.hit();
+        }
+
+        [[nodiscard]] bool contains(const Key &key) const
+        {
+            auto &shard{shard_of(key)};
+            std::shared_lock<std::shared_timed_mutex> lock(shard.mutex);
+            return shard.index.count(key) != 0;
+        }
+
+        bool erase(const Key &key)
+        {
+            auto &shard{shard_of(key)};
+            std::unique_lock<std::shared_timed_mutex> lock(shard.mutex);
+            const auto it{shard.index.find(key)};
+            if (it == shard.index.end())
+                return false;
+            shard.erase(it);
+            return true;
+        }
+
+        // Evicts entries, coldest first in every shard, until target bytes have been freed or the cache is empty.
+        // Suitable as the reclaim callback of a reclaimer_registry.
+        template<typename Rep, typename Factor>
+        bytes evict(const memory_size<Rep, Factor> &target)
+        {
+            const auto requested{memory_size_cast<bytes>(target)};
+            auto freed{bytes::zero()};
+            for (bool progress{true}; freed < requested && progress;) {
+                progress = false;
+                for (auto &shard : shards) {
+                    std::unique_lock<std::shared_timed_mutex> lock(shard.mutex);
+                    if (freed >= requested || shard.entries.empty())
+                        continue;
+                    freed += shard.evict(policy);
+                    progress = true;
+                }
+            }
+            return freed;
+        }
+
+        void clear()
+        {
+            for (auto &shard : shards) {
+                std::unique_lock<std::shared_timed_mutex> lock(shard.mutex);
+                shard.index.clear();
+                shard.entries.clear();
+                shard.hand = shard.entries.end();
+                shard.usage = bytes::zero();
+            }
+        }
+
+        [[nodiscard]] bytes capacity() const
+        {
+            auto total{bytes::zero()};
+            for (const auto &shard : shards)
+                total += shard.capacity;
+            return total;
+        }
+
+        [[nodiscard]] bytes usage() const
+        {
+            auto total{bytes::zero()};
+            for (auto &shard : shards) {
+                std::shared_lock<std::shared_timed_mutex> lock(shard.mutex);
+                total += shard.usage;
+            }
+            return total;
+        }
+
+        [[nodiscard]] cache_statistics statistics() const
+        {
+            cache_statistics statistics{capacity(), bytes::zero(), 0, 0, 0, 0, bytes::zero()};
+            for (auto &shard : shards) {
+                std::shared_lock<std::shared_timed_mutex> lock(shard.mutex);
+                statistics.usage += shard.usage;
+                statistics.entries += shard.index.size();
+                statistics.hits += shard.hits.load(std::memory_order_relaxed);
+                statistics.misses += shard.misses.load(std::memory_order_relaxed);
+                statistics.evictions += shard.evictions;
+                statistics.evicted += shard.evicted;
+            }
+            return statistics;
+        }
+
+        [[nodiscard]] std::size_t shard_count() const { return shards.size(); }
+
+    private:
+        struct node {
+            node(const Key &key, Value value, const bytes charge) : key(key), value(std::move(value)), charge(charge)
+            {
+            }
+
+            Key key;
+            Value value;
+            bytes charge;
+            std::atomic<bool> visited{false};
+        };
+
+        using node_list = std::list<node>;
+
+        struct shard {
+            using index_type = std::unordered_map<Key, typename node_list::iterator, Hash>;
+
+            bool hit()
+            {
+                hits.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+
+            bool miss()
+            {
+                misses.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            void erase(const typename index_type::iterator it)
+            {
+                if (hand == it->second)
+                    hand = hand == entries.begin() ? entries.end() : std::prev(hand);
+                usage -= it->second->charge;
+                entries.erase(it->second);
+                index.erase(it);
+            }
+
+            // Removes one entry and returns its charge. LRU drops the tail, SIEVE moves its hand from the tail
+            // towards the head, clearing the visited bits, and drops the first entry that was not visited.
+            bytes evict(const eviction_policy policy)
+            {
+                auto victim{std::prev(entries.end())};
+                if (policy == eviction_policy::sieve) {
+                    auto current{hand == entries.end() ? std::prev(entries.end()) : hand};
+                    while (current->visited.load(std::memory_order_relaxed)) {
+                        current->visited.store(false, std::memory_order_relaxed);
+                        current = current == entries.begin() ? std::prev(entries.end()) : std::prev(current);
+                    }
+                    victim = current;
+                    hand = current == entries.begin() ? entries.end() : std::prev(current);
+                }
+                const auto charge{victim->charge};
+                ++evictions;
+                evicted += charge;
+                usage -= charge;
+                index.erase(victim->key);
+                entries.erase(victim);
+                return charge;
+            }
+
+            mutable std::shared_timed_mutex mutex;
+            node_list entries;
+            index_type index;
+            typename node_list::iterator hand{entries.end()};
+            bytes capacity{};
+            bytes usage{};
+            std::uint64_t evictions{0};
+            bytes evicted{};
+            std::atomic<std::uint64_t> hits{0};
+            std::atomic<std::uint64_t> misses{0};
+        };
+
+        shard &shard_of(const Key &key) const
+        {
+            // Fibonacci hashing spreads identity hashes, such as the ones of integers, over the shards.
+            const auto mixed{static_cast<std::uint64_t>(hasher(key)) * 0x9E3779B97F4A7C15ULL};
+            return shards[static_cast<std::size_t>((mixed >> 32) % shards.size())];
+        }
+
+        eviction_policy policy;
+        SizeFn size_of;
+        Hash hasher;
+        mutable std::vector<shard> shards;
+    };
+} // namespace mu
+
+#endif // MEMORY_UNITS_CACHE_HPP
@@ -0,0 +1,273 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#ifndef MEMORY_UNITS_CGROUP_HPP
+#define MEMORY_UNITS_CGROUP_HPP
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include "memory_units_process_memory.hpp"
+
+namespace mu
+{
+    namespace details
+    {
+        // Reads a cgroup interface file holding a single size, "max" meaning unlimited. Returns false when the file
+        // does not exist, which is the case of the limits of the root cgroup.
+        inline bool read_cgroup_size(const std::string &path, bytes &size)
+        {
+            const auto file{open_read_only(path)};
+            if (!file.valid())
+                return false;
+            char buffer[64];
+            const auto length{read_from_start(file, buffer, sizeof(buffer))};
+            if (length >= 3 && buffer[0] == 'm' && buffer[1] == 'a' && buffer[2] == 'x') {
+                size = bytes::max();
+                return true;
+            }
+            std::uint64_t value{0};
+            parse_unsigned(buffer, buffer + length, value);
+            size = bytes(value);
+            return true;
+        }
+
+        inline std::string read_text_file(const std::string &path)
+        {
+            const auto file{open_read_only(path)};
+            if (!file.valid())
+                throw std::system_error(errno, std::generic_category(), "Unable to open " + path);
+            char buffer[4096];
+            return std::string(buffer, read_from_start(file, buffer, sizeof(buffer)));
+        }
+    } // namespace details
+
+    namespace cgroup
+    {
+        // Sizes of the memory controller. Limits that are not set are reported as bytes::max().
+        struct memory_limits {
+            bytes max;
+            bytes high;
+            bytes current;
+
+            [[nodiscard]] bytes headroom() const
+            {
+                const auto limit{std::min(max, high)};
+                return current < limit ? limit - current : bytes::zero();
+            }
+        };
+
+        // Path of the cgroup v2 the process belongs to, relative to the cgroup2 mount point.
+        inline std::string current_path(const std::string &membership = "/proc/self/cgroup")
+        {
+            const auto content{details::read_text_file(membership)};
+            std::size_t begin{0};
+            while (begin < content.size()) {
+                auto end{content.find('\n', begin)};
+                if (end == std::string::npos)
+                    end = content.size();
+                if (content.compare(begin, 3, "0::") == 0)
+                    return content.substr(begin + 3, end - begin - 3);
+                begin = end + 1;
+            }
+            throw std::runtime_error("The process does not belong to a cgroup v2 hierarchy");
+        }
+
+        inline std::string current_directory(const std::string &mount_point = "/sys/fs/cgroup",
+                                              const std::string &membership = "/proc/self/cgroup")
+        {
+            const auto path{current_path(membership)};
+            return path == "/" ? mount_point : mount_point + path;
+        }
+
+        // Resolves the effective limits of the current cgroup: a cgroup can never use more than any of its
+        // ancestors allow, so the tightest limit from the leaf up to the mount point wins.
+        inline memory_limits limits(const std::string &mount_point = "/sys/fs/cgroup",
+                                    const std::string &membership = "/proc/self/cgroup")
+        {
+            memory_limits resolved{bytes::max(), bytes::max(), bytes::zero()};
+            auto directory{current_directory(mount_point, membership)};
+            details::read_cgroup_size(directory + "/memory.current", resolved.current);
+            while (true) {
+                bytes size{};
+                if (details::read_cgroup_size(directory + "/memory.max", size) && size < resolved.max)
+                    resolved.max = size;
+                if (details::read_cgroup_size(directory + "/memory.high", size) && size < resolved.high)
+                    resolved.high = size;
+                if (directory.size() <= mount_point.size())
+                    break;
+                directory.erase(directory.rfind('/'));
+            }
+            return resolved;
+        }
+
+        enum class stall { some, full };
+
+        struct pressure {
+            double avg10;
+            double avg60;
+            double avg300;
+            std::chrono::microseconds total;
+        };
+
+        struct memory_pressure {
+            pressure some;
+            pressure full;
+        };
+
+        // Parses the "some avg10=0.00 avg60=0.00 avg300=0.00 total=0" lines of memory.pressure.
+        inline memory_pressure read_pressure(const std::string &cgroup_directory)
+        {
+            const auto content{details::read_text_file(cgroup_directory + "/memory.pressure")};
+            memory_pressure parsed{};
+            std::size_t begin{0};
+            while (begin < content.size()) {
+                auto end{content.find('\n', begin)};
+                if (end == std::string::npos)
+                    end = content.size();
+                const auto line{content.substr(begin, end - begin)};
+                auto &target{line.compare(0, 4, "full") == 0 ? parsed.full : parsed.some};
+                const auto field = [&line](const char *key) {
+                    const auto position{line.find(key)};
+                    return position == std::string::npos ? std::string{} : line.substr(position + std::strlen(key));
+                };
+                target.avg10 = std::strtod(field("avg10=").c_str(), nullptr);
+                target.avg60 = std::strtod(field("avg60=").c_str(), nullptr);
+                target.avg300 = std::strtod(field("avg300=").c_str(), nullptr);
+                target.total = std::chrono::microseconds(std::strtoull(field("total=").c_str(), nullptr, 10));
+                begin = end + 1;
+            }
+            return parsed;
+        }
+
+        // Subscribes to PSI triggers of memory.pressure and runs the callbacks from a dedicated thread that sleeps
+        // in poll() until the kernel reports a stall above a threshold, so there is no periodic sampling at all.
+        // Every trigger needs its own descriptor, the kernel binds the trigger to the open file.
+        class pressure_watcher {
+        public:
+            using callback = std::function<void(stall)>;
+
+            pressure_watcher() : pressure_watcher(current_directory()) {}
+
+            explicit pressure_watcher(std::string cgroup_directory) :
+                directory(std::move(cgroup_directory)), wake(::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK))
+            {
+                if (!wake.valid())
+                    throw std::system_error(errno, std::generic_category(), "Unable to create the wake up event");
+            }
+
+            pressure_watcher(const pressure_watcher &) = delete;
+
+            pressure_watcher &operator=(const pressure_watcher &) = delete;
+
+            // Fires the callback whenever the tasks of the cgroup stall for more than threshold within window.
+            void subscribe(const stall kind, const std::chrono::microseconds threshold,
+                           const std::chrono::microseconds window, callback on_pressure)
+            {
+                if (worker.joinable())
+                    throw std::logic_error("Subscriptions must be made before the watcher is started");
+                const auto path{directory + "/memory.pressure"};
+                details::file_descriptor trigger(::open(path.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC));
+                if (!trigger.valid())
+                    throw std::system_error(errno, std::generic_category(), "Unable to open " + path);
+                const auto request{std::string(kind == stall::some ? "some " : "full ") +
+                                   std::to_string(threshold.count()) + " " + std::to_string(window.count())};
+                if (::write(trigger.get(), request.c_str(), request.size() + 1) < 0)
+                    throw std::system_error(errno, std::generic_category(), "Unable to register the PSI trigger");
+                subscriptions.push_back(subscription{std::move(trigger), kind, std::move(on_pressure)});
+            }
+
+            void start()
+            {
+                if (worker.joinable())
+                    return;
+                running = true;
+                worker = std::thread(&pressure_watcher::watch, this);
+            }
+
+            void stop()
+            {
+                if (!worker.joinable())
+                    return;
+                running = false;
+                const std::uint64_t one{1};
+                static_cast<void>(::write(wake.get(), &one, sizeof(one)));
+                worker.join();
+            }
+
+            [[nodiscard]] const std::string &cgroup_directory() const { return directory; }
+
+            ~pressure_watcher() { stop(); }
+
+        private:
+            struct subscription {
+                details::file_descriptor trigger;
+                stall kind;
+                callback on_pressure;
+            };
+
+            void watch()
+            {
+                std::vector<pollfd> descriptors;
+                descriptors.push_back(pollfd{wake.get(), POLLIN, 0});
+                for (const auto &entry : subscriptions)
+                    descriptors.push_back(pollfd{entry.trigger.get(), POLLPRI, 0});
+                while (running) {
+                    if (::poll(descriptors.data(), descriptors.size(), -1) < 0) {
+                        if (errno == EINTR)
+                            continue;
+                        break;
+                    }
+                    // Drained, or the next start() would find the event still set and never sleep again.
+                    if (descriptors[0].revents & POLLIN) {
+                        std::uint64_t wakes;
+                        static_cast<void>(::read(wake.get(), &wakes, sizeof(wakes)));
+                    }
+                    for (std::size_t i{1}; i < descriptors.size(); ++i) {
+                        auto &descriptor{descriptors[i]};
+                        if (descriptor.revents & POLLERR)
+                            descriptor.fd = -1; // The cgroup has been removed, poll() ignores negative descriptors.
+                        else if (descriptor.revents & POLLPRI)
+                            subscriptions[i - 1].on_pressure(subscriptions[i - 1].kind);
+                    }
+                }
+            }
+
+            std::string directory;
+            details::file_descriptor wake;
+            std::vector<subscription> subscriptions;
+            std::atomic<bool> running{false};
+            std::thread worker;
+        };
+    } // namespace cgroup
+} // namespace mu
+
+#endif // MEMORY_UNITS_CGROUP_HPP
@@ -0,0 +1,455 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#ifndef MEMORY_UNITS_DISK_CACHE_HPP
+#define MEMORY_UNITS_DISK_CACHE_HPP
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <dirent.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "memory_units_posix.hpp"
+
+namespace mu
+{
+    namespace details
+    {
+        struct disk_cache_header {
+            std::uint64_t magic;
+            std::uint64_t slot_count;
+            std::uint64_t entry_count;
+            std::uint64_t usage;
+            std::uint64_t clock;
+            std::uint64_t hand;
+            std::uint64_t generation;
+            std::uint64_t reserved;
+        };
+
+        // A slot of the open addressing table of the index. A zero key hash marks an empty slot.
+        struct disk_cache_record {
+            std::uint64_t key_hash;
+            std::uint64_t size;
+            std::uint64_t last_access;
+            std::uint64_t generation;
+        };
+
+        // Start of every blob, followed by the key and the content. A blob is only served when its generation is
+        // the one of the record and its key is the requested one, so that neither a blob replaced concurrently nor
+        // a key with the same hash is ever returned as a hit.
+        struct disk_cache_blob_header {
+            std::uint64_t magic;
+            std::uint64_t generation;
+            std::uint64_t key_size;
+            std::uint64_t size;
+        };
+
+        inline std::uint64_t fnv1a(const std::string &key)
+        {
+            std::uint64_t hash{0xCBF29CE484222325ULL};
+            for (const auto c : key)
+                hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001B3ULL;
+            return hash | 1; // Never zero, which marks the empty slots
+        }
+    } // namespace details
+
+    // On-disk blob cache bounded by a memory_size. The entries are tracked by a fixed-size index file mapped in
+    // memory, so opening the cache never reads a blob: it maps the index and only lists the blob directory, to remove
+    // the blobs and temporary files a crash left behind without an entry. Updates of the index are plain stores into
+    // the mapping, flushed to disk every sync_interval mutations. The index only keeps the 64-bit hash of the keys;
+    // the keys themselves are checked against the blobs. Every entry is charged for its whole blob, header and key
+    // included. A cache directory must not be shared by several processes.
+    class disk_cache {
+    public:
+        template<typename Rep, typename Factor>
+        disk_cache(std::string directory, const memory_size<Rep, Factor> &capacity,
+                   const std::size_t max_entries = 1 << 20, const std::size_t sync_interval = 64) :
+            root(std::move(directory)), limit(memory_size_cast<bytes>(capacity)), sync_interval(sync_interval)
+        {
+            make_directory(root);
+            make_directory(root + "/objects");
+            map_index(max_entries);
+            remove_orphans();
+        }
+
+        disk_cache(const disk_cache &) = delete;
+
+        disk_cache &operator=(const disk_cache &) = delete;
+
+        // The blob is written to a unique temporary file, then published and recorded in the index in a single
+        // step under the lock, so that concurrent puts of a key never mix their content.
+        bool put(const std::string &key, const void *data, const std::size_t size)
+        {
+            const auto charge{charge_of(key, size)};
+            if (charge > limit)
+                return false;
+            const auto hash{details::fnv1a(key)};
+            const auto path{blob_path(hash)};
+            auto temporary{root + "/objects/.tmp-XXXXXX"};
+            const details::file_descriptor file(::mkostemp(&temporary[0], O_CLOEXEC));
+            if (!file.valid())
+                throw std::system_error(errno, std::generic_category(), "Unable to create " + temporary);
+            try {
+                details::disk_cache_blob_header blob{blob_magic, 0, key.size(), size};
+                details::write_all(file, reinterpret_cast<const char *>(&blob), sizeof(blob));
+                details::write_all(file, key.data(), key.size());
+                details::write_all(file, static_cast<const char *>(data), size);
+
+                std::lock_guard<std::mutex> lock(mutex);
+                const auto generation{++header->generation};
+                if (::pwrite(file.get(), &generation, sizeof(generation),
+                             offsetof(details::disk_cache_blob_header, generation)) != sizeof(generation))
+                    throw std::system_error(errno, std::generic_category(), "Unable to write " + temporary);
+                if (::rename(temporary.c_str(), path.c_str()) != 0)
+                    throw std::system_error(errno, std::generic_category(), "Unable to publish " + path);
+                store(hash, charge, generation);
+            }
+            catch (...) {
+                ::unlink(temporary.c_str());
+                throw;
+            }
+            return true;
+        }
+
+        bool put(const std::string &key, const std::string &content)
+        {
+            return put(key, content.data(), content.size());
+        }
+
+        bool get(const std::string &key, std::string &content)
+        {
+            const auto hash{details::fnv1a(key)};
+            for (unsigned attempt{0}; attempt < max_read_attempts; ++attempt) {
+                std::uint64_t generation;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    const auto slot{find(hash)};
+                    if (slot == npos)
+                        return false;
+                    records[slot].last_access = ++header->clock;
+                    generation = records[slot].generation;
+                }
+                switch (read_blob(hash, generation, key, content)) {
+                    case blob_status::valid:
+                        return true;
+                    case blob_status::other_key:
+                        return false;
+                    case blob_status::replaced:
+                        continue;
+                    case blob_status::damaged:
+                        forget(hash, generation); // The blob was removed or truncated behind our back
+                        return false;
+                }
+            }
+            return false;
+        }
+
+        [[nodiscard]] bool contains(const std::string &key) const
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return find(details::fnv1a(key)) != npos;
+        }
+
+        bool erase(const std::string &key)
+        {
+            const auto hash{details::fnv1a(key)};
+            std::lock_guard<std::mutex> lock(mutex);
+            const auto slot{find(hash)};
+            if (slot == npos)
+                return false;
+            remove(slot);
+            ::unlink(blob_path(hash).c_str());
+            mutated();
+            return true;
+        }
+
+        [[nodiscard]] bytes usage() const
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return bytes(header->usage);
+        }
+
+        [[nodiscard]] bytes capacity() const { return limit; }
+
+        [[nodiscard]] std::size_t size() const
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return static_cast<std::size_t>(header->entry_count);
+        }
+
+        // The index table is kept at most three quarters full.
+        [[nodiscard]] std::size_t max_entries() const { return static_cast<std::size_t>(header->slot_count / 4 * 3); }
+
+        // Size of the index file, the only thing read at startup.
+        [[nodiscard]] bytes index_size() const { return bytes(mapping_size); }
+
+        void flush()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ::msync(mapping, mapping_size, MS_SYNC);
+            pending = 0;
+        }
+
+        ~disk_cache()
+        {
+            ::msync(mapping, mapping_size, MS_SYNC);
+            ::munmap(mapping, mapping_size);
+        }
+
+    private:
+        static constexpr std::uint64_t magic{0x4D554449534B3032ULL};      // "MUDISK02"
+        static constexpr std::uint64_t blob_magic{0x4D55424C4F423031ULL}; // "MUBLOB01"
+        static constexpr unsigned max_read_attempts{4};
+
+        enum class blob_status { valid, other_key, replaced, damaged };
+
+        static constexpr std::size_t npos{static_cast<std::size_t>(-1)};
+        static constexpr std::size_t eviction_window{16};
+
+        static void make_directory(const std::string &path)
+        {
+            if (::mkdir(path.c_str(), 0700) != 0 && errno != EEXIST)
+                throw std::system_error(errno, std::generic_category(), "Unable to create " + path);
+        }
+
+        static bytes charge_of(const std::string &key, const std::size_t size)
+        {
+            return bytes(sizeof(details::disk_cache_blob_header) + key.size() + size);
+        }
+
+        static bool is_blob_name(const std::string &name)
+        {
+            return name.size() == 16 && name.find_first_not_of("0123456789abcdef") == std::string::npos;
+        }
+
+        // A crash between the publication of a blob and its record in the index, or before the publication, leaves
+        // files no entry accounts for.
+        void remove_orphans()
+        {
+            const auto path{root + "/objects"};
+            auto *const directory{::opendir(path.c_str())};
+            if (directory == nullptr)
+                throw std::system_error(errno, std::generic_category(), "Unable to list " + path);
+            while (const auto *entry{::readdir(directory)}) {
+                const std::string name{entry->d_name};
+                if (name.compare(0, 5, ".tmp-") == 0 ||
+                    (is_blob_name(name) && find(std::strtoull(name.c_str(), nullptr, 16)) == npos))
+                    ::unlinkat(::dirfd(directory), name.c_str(), 0);
+            }
+            ::closedir(directory);
+        }
+
+        void map_index(const std::size_t max_entries)
+        {
+            const auto path{root + "/index"};
+            details::file_descriptor file(::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600));
+            if (!file.valid())
+                throw std::system_error(errno, std::generic_category(), "Unable to open " + path);
+            struct stat status{};
+            if (::fstat(file.get(), &status) != 0)
+                throw std::system_error(errno, std::generic_category(), "Unable to stat " + path);
+            auto slot_count{std::uint64_t{16}};
+            if (status.st_size == 0) {
+                while (slot_count * 3 < max_entries * 4)
+                    slot_count <<= 1;
+                mapping_size = sizeof(details::disk_cache_header) + slot_count * sizeof(details::disk_cache_record);
+                if (::ftruncate(file.get(), static_cast<off_t>(mapping_size)) != 0)
+                    throw std::system_error(errno, std::generic_category(), "Unable to size " + path);
+            }
+            else
+                mapping_size = static_cast<std::size_t>(status.st_size);
+            mapping = ::mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, file.get(), 0);
+            if (mapping == MAP_FAILED)
+                throw std::system_error(errno, std::generic_category(), "Unable to map " + path);
+            header = static_cast<details::disk_cache_header *>(mapping);
+            records = reinterpret_cast<details::disk_cache_record *>(header + 1);
+            if (status.st_size == 0) {
+                header->magic = magic;
+                header->slot_count = slot_count;
+            }
+            else if (header->magic != magic || mapping_size != sizeof(details::disk_cache_header) +
+                                                                      header->slot_count *
+                                                                              sizeof(details::disk_cache_record)) {
+                ::munmap(mapping, mapping_size);
+                throw std::runtime_error("The disk cache index " + path + " is corrupted");
+            }
+        }
+
+        // Records a published blob. Must be called with the lock held; the evicted blobs are unlinked under the
+        // lock too, so that a concurrent put of an evicted key cannot have its new blob unlinked.
+        void store(const std::uint64_t hash, const bytes charge, const std::uint64_t generation)
+        {
+            auto slot{find(hash)};
+            if (slot == npos) {
+                if (header->entry_count * 4 >= header->slot_count * 3)
+                    evict_one();
+                slot = insert(hash);
+                ++header->entry_count;
+            }
+            else
+                header->usage -= records[slot].size;
+            records[slot].size = charge.count();
+            records[slot].generation = generation;
+            records[slot].last_access = ++header->clock;
+            header->usage += charge.count();
+            while (bytes(header->usage) > limit)
+                evict_one(hash);
+            mutated();
+        }
+
+        // Removes an entry whose blob is damaged, unless it was replaced in the meantime.
+        void forget(const std::uint64_t hash, const std::uint64_t generation)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            const auto slot{find(hash)};
+            if (slot == npos || records[slot].generation != generation)
+                return;
+            remove(slot);
+            ::unlink(blob_path(hash).c_str());
+            mutated();
+        }
+
+        blob_status read_blob(const std::uint64_t hash, const std::uint64_t generation, const std::string &key,
+                              std::string &content) const
+        {
+            const auto file{details::open_read_only(blob_path(hash))};
+            if (!file.valid())
+                return blob_status::damaged;
+            details::disk_cache_blob_header blob{};
+            if (details::read_from(file, reinterpret_cast<char *>(&blob), sizeof(blob), 0) != sizeof(blob) ||
+                blob.magic != blob_magic)
+                return blob_status::damaged;
+            if (blob.generation != generation)
+                return blob.generation > generation ? blob_status::replaced : blob_status::damaged;
+            if (blob.key_size != key.size())
+                return blob_status::other_key;
+            std::string stored_key(key.size(), '\0');
+            if (details::read_from(file, &stored_key[0], key.size(), sizeof(blob)) != key.size())
+                return blob_status::damaged;
+            if (stored_key != key)
+                return blob_status::other_key;
+            content.resize(static_cast<std::size_t>(blob.size));
+            if (details::read_from(file, &content[0], content.size(), sizeof(blob) + key.size()) != content.size())
+                return blob_status::damaged;
+            return blob_status::valid;
+        }
+
+        [[nodiscard]] std::string blob_path(const std::uint64_t hash) const
+        {
+            char name[32];
+            std::snprintf(name, sizeof(name), "/%016llx", static_cast<unsigned long long>(hash));
+            return root + "/objects" + name;
+        }
+
+        [[nodiscard]] std::size_t home(const std::uint64_t hash) const
+        {
+            return static_cast<std::size_t>(hash & (header->slot_count - 1));
+        }
+
+        [[nodiscard]] std::size_t next(const std::size_t slot) const
+        {
+            return static_cast<std::size_t>((slot + 1) & (header->slot_count - 1));
+        }
+
+        [[nodiscard]] std::size_t find(const std::uint64_t hash) const
+        {
+            for (auto slot{home(hash)};; slot = next(slot)) {
+                if (records[slot].key_hash == hash)
+                    return slot;
+                if (records[slot].key_hash == 0)
+                    return npos;
+            }
+        }
+
+        std::size_t insert(const std::uint64_t hash)
+        {
+            auto slot{home(hash)};
+            while (records[slot].key_hash != 0)
+                slot = next(slot);
+            records[slot].key_hash = hash;
+            return slot;
+        }
+
+        // Linear probing deletion by backward shift, so that the table never needs tombstones.
+        void remove(std::size_t slot)
+        {
+            header->usage -= records[slot].size;
+            --header->entry_count;
+            for (auto candidate{next(slot)}; records[candidate].key_hash != 0; candidate = next(candidate)) {
+                const auto wanted{home(records[candidate].key_hash)};
+                const auto distance_to_hole{(slot - wanted) & (header->slot_count - 1)};
+                const auto distance_to_candidate{(candidate - wanted) & (header->slot_count - 1)};
+                if (distance_to_hole < distance_to_candidate) {
+                    records[slot] = records[candidate];
+                    slot = candidate;
+                }
+            }
+            records[slot] = details::disk_cache_record{};
+        }
+
+        // Approximate LRU: the least recently used entry among the next occupied slots after the clock hand is
+        // evicted along with its blob.
+        void evict_one(const std::uint64_t protected_hash = 0)
+        {
+            auto victim{npos};
+            std::size_t seen{0};
+            auto slot{static_cast<std::size_t>(header->hand & (header->slot_count - 1))};
+            for (std::size_t scanned{0}; scanned < header->slot_count && seen < eviction_window; ++scanned) {
+                const auto &record{records[slot]};
+                if (record.key_hash != 0 && record.key_hash != protected_hash) {
+                    ++seen;
+                    if (victim == npos || record.last_access < records[victim].last_access)
+                        victim = slot;
+                }
+                slot = next(slot);
+            }
+            header->hand = slot;
+            if (victim == npos)
+                return;
+            ::unlink(blob_path(records[victim].key_hash).c_str());
+            remove(victim);
+        }
+
+        void mutated()
+        {
+            if (++pending < sync_interval)
+                return;
+            ::msync(mapping, mapping_size, MS_ASYNC);
+            pending = 0;
+        }
+
+        std::string root;
+        bytes limit;
+        std::size_t sync_interval;
+        std::size_t pending{0};
+        void *mapping{nullptr};
+        std::size_t mapping_size{0};
+        details::disk_cache_header *header{nullptr};
+        details::disk_cache_record *records{nullptr};
+        mutable std::mutex mutex;
+    };
+} // namespace mu
+
+#endif // MEMORY_UNITS_DISK_CACHE_HPP
@@ -0,0 +1,427 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#ifndef MEMORY_UNITS_DYNAMIC_HPP
+#define MEMORY_UNITS_DYNAMIC_HPP
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include "memory_units.hpp"
+
+namespace mu
+{
+    // Every predefined unit, for sizes whose unit is only known at runtime.
+    enum class memory_unit : std::uint8_t {
+        b, kb, mb, gb, tb, pb, eb,
+        kib, mib, gib, tib, pib, eib,
+        bit, kbit, mbit, gbit, tbit,
+        kibit, mibit, gibit, tibit,
+        sector, cache_line, page, huge_page
+    };
+
+    namespace details
+    {
+        constexpr std::size_t memory_unit_count{26};
+
+        // Size of the units in bits, so that every factor is an integer.
+        template<typename Factor>
+        struct bits_of : std::integral_constant<std::uint64_t, static_cast<std::uint64_t>(Factor::num) * 8 /
+                                                                       static_cast<std::uint64_t>(Factor::den)> {
+            static_assert(8 % Factor::den == 0, "The factor must be a whole number of bits");
+        };
+
+        constexpr std::uint64_t unit_bits[memory_unit_count]{
+                bits_of<b>::value,     bits_of<kb>::value,     bits_of<mb>::value,     bits_of<gb>::value,
+                bits_of<tb>::value,    bits_of<pb>::value,     bits_of<eb>::value,     bits_of<kib>::value,
+                bits_of<mib>::value,   bits_of<gib>::value,    bits_of<tib>::value,    bits_of<pib>::value,
+                bits_of<eib>::value,   bits_of<bit>::value,    bits_of<kbit>::value,   bits_of<mbit>::value,
+                bits_of<gbit>::value,  bits_of<tbit>::value,   bits_of<kibit>::value,  bits_of<mibit>::value,
+                bits_of<gibit>::value, bits_of<tibit>::value,  bits_of<sector>::value, bits_of<cache_line>::value,
+                bits_of<page>::value,  bits_of<huge_page>::value};
+
+        constexpr const char *unit_symbols[memory_unit_count]{
+                "B",   "kB",  "MB",  "GB",  "TB",  "PB",     "EB",         "kiB",  "MiB",      "GiB", "TiB",
+                "PiB", "EiB", "b",   "kb",  "Mb",  "Gb",     "Tb",         "kib",  "Mib",      "Gib", "Tib",
+                "sector", "cache_line", "page", "huge_page"};
+
+        template<typename Factor, std::size_t Index = 0>
+        struct unit_of
+            : std::conditional<unit_bits[Index] == bits_of<Factor>::value,
+                               std::integral_constant<memory_unit, static_cast<memory_unit>(Index)>,
+                               unit_of<Factor, Index + 1>>::type {};
+
+        template<typename Factor>
+        struct unit_of<Factor, memory_unit_count> {
+            static_assert(sizeof(Factor) == 0, "The factor is not one of the predefined units");
+        };
+
+        constexpr std::uint64_t gcd(const std::uint64_t lhs, const std::uint64_t rhs)
+        {
+            return rhs == 0 ? lhs : gcd(rhs, lhs % rhs);
+        }
+
+        constexpr unsigned log2_64(const std::uint64_t value) { return value <= 1 ? 0 : 1 + log2_64(value >> 1); }
+
+        // Floor of value * numerator / denominator for a value smaller than the denominator, computed bit by bit
+        // so that the product never overflows.
+        constexpr std::uint64_t multiply_divide(const std::uint64_t value, const std::uint64_t numerator,
+                                                const std::uint64_t denominator)
+        {
+            std::uint64_t quotient{0};
+            std::uint64_t remainder{0};
+            for (auto bit{64}; bit-- > 0;) {
+                quotient <<= 1;
+                if (remainder >= denominator - remainder) {
+                    remainder -= denominator - remainder;
+                    ++quotient;
+                }
+                else
+                    remainder <<= 1;
+                if ((numerator >> bit) & 1) {
+                    if (remainder >= denominator - value) {
+                        remainder -= denominator - value;
+                        ++quotient;
+                    }
+                    else
+                        remainder += value;
+                }
+            }
+            return quotient;
+        }
+
+        // Floor of value * numerator / denominator. Throws std::overflow_error when the result does not fit in 64
+        // bits, but not when only the intermediate product would.
+        constexpr std::uint64_t checked_multiply_divide(const std::uint64_t value, const std::uint64_t numerator,
+                                                        const std::uint64_t denominator)
+        {
+            const auto limit{std::numeric_limits<std::uint64_t>::max() / numerator};
+            if (value <= limit)
+                return value * numerator / denominator;
+            const auto whole{value / denominator};
+            if (whole > limit)
+                throw std::overflow_error("The converted size does not fit in 64 bits");
+            const auto scaled{whole * numerator};
+            const auto rest{multiply_divide(value % denominator, numerator, denominator)};
+            if (rest > std::numeric_limits<std::uint64_t>::max() - scaled)
+                throw std::overflow_error("The converted size does not fit in 64 bits");
+            return scaled + rest;
+        }
+
+        // Sum, difference and product of counts. Throw std::overflow_error when the result does not fit in 64 bits
+        // or would be negative.
+        constexpr std::uint64_t checked_add(const std::uint64_t lhs, const std::uint64_t rhs)
+        {
+            if (rhs > std::numeric_limits<std::uint64_t>::max() - lhs)
+                throw std::overflow_error("The sum does not fit in 64 bits");
+            return lhs + rhs;
+        }
+
+        constexpr std::uint64_t checked_subtract(const std::uint64_t lhs, const std::uint64_t rhs)
+        {
+            if (rhs > lhs)
+                throw std::overflow_error("The difference is negative");
+            return lhs - rhs;
+        }
+
+        constexpr std::uint64_t checked_multiply(const std::uint64_t lhs, const std::uint64_t rhs)
+        {
+            if (lhs != 0 && rhs > std::numeric_limits<std::uint64_t>::max() / lhs)
+                throw std::overflow_error("The product does not fit in 64 bits");
+            return lhs * rhs;
+        }
+
+        // The count of a static size as a dynamic count. Throws std::overflow_error when it is negative.
+        template<typename Rep>
+        constexpr std::uint64_t checked_count(const Rep count)
+        {
+            if (sign_of<Rep>::is_negative(count))
+                throw std::overflow_error("A negative size does not fit in a dynamic_memory_size");
+            return static_cast<std::uint64_t>(count);
+        }
+
+        // For each pair of units, the coarsest unit both are multiples of, and the multiplier taking a count of
+        // each unit to a count of that common unit. When the greatest common factor is not a unit itself, the
+        // common unit is the byte, or the bit for sizes that are not whole bytes.
+        struct unit_matrix {
+            memory_unit common[memory_unit_count][memory_unit_count];
+            std::uint64_t multiplier[memory_unit_count][memory_unit_count];
+        };
+
+        constexpr unit_matrix make_unit_matrix()
+        {
+            unit_matrix matrix{};
+            for (std::size_t from{0}; from < memory_unit_count; ++from) {
+                for (std::size_t other{0}; other < memory_unit_count; ++other) {
+                    const auto greatest{gcd(unit_bits[from], unit_bits[other])};
+                    auto common{greatest % 8 == 0 ? memory_unit::b : memory_unit::bit};
+                    for (std::size_t candidate{0}; candidate < memory_unit_count; ++candidate)
+                        if (unit_bits[candidate] == greatest)
+                            common = static_cast<memory_unit>(candidate);
+                    matrix.common[from][other] = common;
+                }
+                for (std::size_t to{0}; to < memory_unit_count; ++to)
+                    matrix.multiplier[from][to] =
+                            unit_bits[from] % unit_bits[to] == 0 ? unit_bits[from] / unit_bits[to] : 0;
+            }
+            return matrix;
+        }
+
+        constexpr unit_matrix unit_conversions{make_unit_matrix()};
+
+        // Conversion of a count of each unit to a count of a static factor: a multiplication by the reduced
+        // numerator, then a shift when the reduced denominator is a power of two, which it is for every unit but
+        // the base 10 ones converted to base 2. Counts above the limit would overflow the multiplication and are
+        // divided first.
+        struct static_conversion {
+            std::uint64_t numerator;
+            std::uint64_t denominator;
+            unsigned shift;
+            bool shifts;
+            std::uint64_t limit;
+        };
+
+        struct static_conversions {
+            static_conversion entries[memory_unit_count];
+        };
+
+        constexpr static_conversions make_static_conversions(const std::uint64_t target_bits)
+        {
+            static_conversions result{};
+            for (std::size_t unit{0}; unit < memory_unit_count; ++unit) {
+                const auto divisor{gcd(unit_bits[unit], target_bits)};
+                const auto denominator{target_bits / divisor};
+                const auto numerator{unit_bits[unit] / divisor};
+                result.entries[unit] = static_conversion{numerator, denominator, log2_64(denominator),
+                                                         is_power_of_two(denominator),
+                                                         std::numeric_limits<std::uint64_t>::max() / numerator};
+            }
+            return result;
+        }
+
+        template<typename Factor>
+        struct static_conversion_table {
+            static constexpr static_conversions value{make_static_conversions(bits_of<Factor>::value)};
+        };
+
+        template<typename Factor>
+        constexpr static_conversions static_conversion_table<Factor>::value;
+    } // namespace details
+
+    [[nodiscard]] constexpr const char *symbol(const memory_unit unit)
+    {
+        return details::unit_symbols[static_cast<std::size_t>(unit)];
+    }
+
+    // Parses a unit symbol as printed by symbol(), e.g. "MiB" or "Gb".
+    inline memory_unit parse_memory_unit(const std::string &text)
+    {
+        for (std::size_t unit{0}; unit < details::memory_unit_count; ++unit)
+            if (text == details::unit_symbols[unit])
+                return static_cast<memory_unit>(unit);
+        throw std::invalid_argument("Unknown memory unit: " + text);
+    }
+
+    // A count and a unit chosen at runtime, in 16 bytes. Arithmetic between sizes of different units happens in
+    // their common unit, found with the multipliers in a precomputed matrix rather than by branching on the units.
+    class dynamic_memory_size {
+    public:
+        constexpr dynamic_memory_size() = default;
+
+        constexpr dynamic_memory_size(const std::uint64_t count, const memory_unit unit) : quantity(count), unit_(unit)
+        {
+        }
+
+        // Throws std::overflow_error when the count is negative.
+        template<typename Rep, typename Factor>
+        constexpr dynamic_memory_size(const memory_size<Rep, Factor> &size) :
+            quantity(details::checked_count(size.count())), unit_(details::unit_of<Factor>::value)
+        {
+            static_assert(std::is_integral<Rep>::value, "Only integral sizes can be held by a dynamic_memory_size");
+        }
+
+        [[nodiscard]] constexpr std::uint64_t count() const { return quantity; }
+
+        [[nodiscard]] constexpr memory_unit unit() const { return unit_; }
+
+        // Converts to another unit, truncating like memory_size_cast. Throws std::overflow_error when the converted
+        // count does not fit in 64 bits.
+        [[nodiscard]] constexpr dynamic_memory_size in(const memory_unit unit) const
+        {
+            const auto from{static_cast<std::size_t>(unit_)};
+            const auto to{static_cast<std::size_t>(unit)};
+            const auto multiplier{details::unit_conversions.multiplier[from][to]};
+            if (multiplier != 0)
+                return dynamic_memory_size(details::checked_multiply_divide(quantity, multiplier, 1), unit);
+            const auto divisor{details::gcd(details::unit_bits[from], details::unit_bits[to])};
+            return dynamic_memory_size(details::checked_multiply_divide(quantity, details::unit_bits[from] / divisor,
+                                                                        details::unit_bits[to] / divisor),
+                                       unit);
+        }
+
+        // Converts to a static size, truncating like memory_size_cast when the target is integral. Throws
+        // std::overflow_error when the converted count does not fit in 64 bits.
+        template<typename To>
+        [[nodiscard]] constexpr details::Precondition<details::is_memory_size<To>::value, To> as() const
+        {
+            using target_rep = typename To::rep;
+            const auto &conversion{
+                    details::static_conversion_table<typename To::factor>::value
+                            .entries[static_cast<std::size_t>(unit_)]};
+            return To(convert<target_rep>(conversion, std::is_floating_point<target_rep>()));
+        }
+
+        template<typename Rep, typename Factor,
+                 typename = details::Precondition<std::is_integral<Rep>::value || std::is_floating_point<Rep>::value>>
+        constexpr explicit operator memory_size<Rep, Factor>() const
+        {
+            return as<memory_size<Rep, Factor>>();
+        }
+
+        [[nodiscard]] constexpr bytes to_bytes() const { return as<bytes>(); }
+
+        constexpr dynamic_memory_size &operator+=(const dynamic_memory_size &other) { return *this = *this + other; }
+
+        constexpr dynamic_memory_size &operator-=(const dynamic_memory_size &other) { return *this = *this - other; }
+
+        constexpr dynamic_memory_size &operator*=(const std::uint64_t factor) { return *this = *this * factor; }
+
+        constexpr dynamic_memory_size &operator/=(const std::uint64_t divisor)
+        {
+            quantity /= divisor;
+            return *this;
+        }
+
+        // Like conversions, sums, differences and products throw std::overflow_error when they do not fit.
+        friend constexpr dynamic_memory_size operator+(const dynamic_memory_size &lhs, const dynamic_memory_size &rhs)
+        {
+            const auto common{lhs.common_unit(rhs)};
+            return dynamic_memory_size(details::checked_add(lhs.count_in(common), rhs.count_in(common)), common);
+        }
+
+        friend constexpr dynamic_memory_size operator-(const dynamic_memory_size &lhs, const dynamic_memory_size &rhs)
+        {
+            const auto common{lhs.common_unit(rhs)};
+            return dynamic_memory_size(details::checked_subtract(lhs.count_in(common), rhs.count_in(common)), common);
+        }
+
+        friend constexpr dynamic_memory_size operator*(const dynamic_memory_size &lhs, const std::uint64_t rhs)
+        {
+            return dynamic_memory_size(details::checked_multiply(lhs.quantity, rhs), lhs.unit_);
+        }
+
+        friend constexpr dynamic_memory_size operator*(const std::uint64_t lhs, const dynamic_memory_size &rhs)
+        {
+            return rhs * lhs;
+        }
+
+        friend constexpr dynamic_memory_size operator/(const dynamic_memory_size &lhs, const std::uint64_t rhs)
+        {
+            return dynamic_memory_size(lhs.quantity / rhs, lhs.unit_);
+        }
+
+        friend constexpr std::uint64_t operator/(const dynamic_memory_size &lhs, const dynamic_memory_size &rhs)
+        {
+            const auto common{lhs.common_unit(rhs)};
+            return lhs.count_in(common) / rhs.count_in(common);
+        }
+
+        friend constexpr bool operator==(const dynamic_memory_size &lhs, const dynamic_memory_size &rhs)
+        {
+            const auto common{lhs.common_unit(rhs)};
+            return lhs.count_in(common) == rhs.count_in(common);
+        }
+
+        friend constexpr bool operator<(const dynamic_memory_size &lhs, const dynamic_memory_size &rhs)
+        {
+            const auto common{lhs.common_unit(rhs)};
+            return lhs.count_in(common) < rhs.count_in(common);
+        }
+
+        friend constexpr bool operator!=(const dynamic_memory_size &lhs, const dynamic_memory_size &rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+        friend constexpr bool operator<=(const dynamic_memory_size &lhs, const dynamic_memory_size &rhs)
+        {
+            return !(rhs < lhs);
+        }
+
+        friend constexpr bool operator>(const dynamic_memory_size &lhs, const dynamic_memory_size &rhs)
+        {
+            return rhs < lhs;
+        }
+
+        friend constexpr bool operator>=(const dynamic_memory_size &lhs, const dynamic_memory_size &rhs)
+        {
+            return !(lhs < rhs);
+        }
+
+    private:
+        [[nodiscard]] constexpr memory_unit common_unit(const dynamic_memory_size &other) const
+        {
+            return details::unit_conversions.common[static_cast<std::size_t>(unit_)]
+                                                    [static_cast<std::size_t>(other.unit_)];
+        }
+
+        // The common unit always divides the unit, so the multiplier is exact. Throws std::overflow_error when the
+        // count in the common unit does not fit in 64 bits.
+        [[nodiscard]] constexpr std::uint64_t count_in(const memory_unit common) const
+        {
+            const auto from{static_cast<std::size_t>(unit_)};
+            return details::checked_multiply_divide(
+                    quantity, details::unit_conversions.multiplier[from][static_cast<std::size_t>(common)], 1);
+        }
+
+        template<typename Rep>
+        constexpr Rep convert(const details::static_conversion &conversion, std::true_type) const
+        {
+            return static_cast<Rep>(quantity) * static_cast<Rep>(conversion.numerator) /
+                   static_cast<Rep>(conversion.denominator);
+        }
+
+        template<typename Rep>
+        constexpr Rep convert(const details::static_conversion &conversion, std::false_type) const
+        {
+            if (quantity <= conversion.limit) {
+                const auto scaled{quantity * conversion.numerator};
+                return static_cast<Rep>(conversion.shifts ? scaled >> conversion.shift
+                                                          : scaled / conversion.denominator);
+            }
+            return static_cast<Rep>(
+                    details::checked_multiply_divide(quantity, conversion.numerator, conversion.denominator));
+        }
+
+        std::uint64_t quantity{0};
+        memory_unit unit_{memory_unit::b};
+    };
+
+    template<typename To>
+    constexpr details::Precondition<details::is_memory_size<To>::value, To>
+    memory_size_cast(const dynamic_memory_size &from)
+    {
+        return from.as<To>();
+    }
+} // namespace mu
+
+#endif // MEMORY_UNITS_DYNAMIC_HPP
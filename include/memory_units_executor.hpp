@@ -0,0 +1,313 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#ifndef MEMORY_UNITS_EXECUTOR_HPP
+#define MEMORY_UNITS_EXECUTOR_HPP
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "memory_units.hpp"
+
+namespace mu
+{
+    // Thread pool admitting tasks by their declared memory footprint, so that the footprints of the running tasks
+    // never add up to more than a budget. Tasks start in submission order, except that smaller tasks are backfilled
+    // around a task that does not fit yet, a bounded number of times so that large tasks cannot starve. A task
+    // larger than the whole budget runs alone.
+    //
+    // When a memory probe (e.g. the resident set size of the process) is given, it is sampled while tasks run, and
+    // the growth between two samples is split between the running tasks in proportion to their charge. The peak
+    // growth attributed to a task corrects the estimates of the next tasks of the same named kind. Corrections only
+    // ever raise the declared footprint: an allocator reusing freed memory hides the footprint of a task from the
+    // probe, and memory freed by a task is attributed to the others as negative growth, so that a small observed
+    // growth does not mean a small footprint.
+    class memory_aware_executor {
+    public:
+        using memory_probe = std::function<bytes()>;
+
+        template<typename Rep, typename Factor>
+        explicit memory_aware_executor(const memory_size<Rep, Factor> &budget,
+                                       const unsigned thread_count = std::thread::hardware_concurrency(),
+                                       memory_probe probe = memory_probe()) :
+            budget_bytes(memory_size_cast<bytes>(budget).count()), probe(std::move(probe)),
+            max_bypass(4 * std::max(thread_count, 1u))
+        {
+            for (unsigned i{0}; i < std::max(thread_count, 1u); ++i)
+                workers.emplace_back(&memory_aware_executor::work, this);
+            if (this->probe)
+                workers.emplace_back(&memory_aware_executor::sample, this);
+        }
+
+        memory_aware_executor(const memory_aware_executor &) = delete;
+
+        memory_aware_executor &operator=(const memory_aware_executor &) = delete;
+
+        template<typename Rep, typename Factor, typename Function>
+        std::future<decltype(std::declval<Function &>()())> submit(const memory_size<Rep, Factor> &estimate,
+                                                                   Function &&function)
+        {
+            return submit(std::string(), estimate, std::forward<Function>(function));
+        }
+
+        template<typename Rep, typename Factor, typename Function>
+        std::future<decltype(std::declval<Function &>()())>
+        submit(std::string kind, const memory_size<Rep, Factor> &estimate, Function &&function)
+        {
+            using result_type = decltype(std::declval<Function &>()());
+            auto packaged{std::make_shared<std::packaged_task<result_type()>>(std::forward<Function>(function))};
+            auto result{packaged->get_future()};
+            const auto declared{memory_size_cast<bytes>(estimate).count()};
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                const auto correction{kind.empty() ? corrections.end() : corrections.find(kind)};
+                const auto charge{correction == corrections.end()
+                                          ? declared
+                                          : static_cast<std::uint64_t>(static_cast<double>(declared) *
+                                                                       correction->second)};
+                pending.push_back(task{[packaged]() { (*packaged)(); }, charge, declared, std::move(kind)});
+            }
+            work_available.notify_all();
+            return result;
+        }
+
+        // Current estimate correction of a kind of task: peak observed footprint over declared footprint, at least
+        // 1.
+        [[nodiscard]] double correction(const std::string &kind) const
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            const auto it{corrections.find(kind)};
+            return it == corrections.end() ? 1.0 : it->second;
+        }
+
+        [[nodiscard]] bytes budget() const { return bytes(budget_bytes); }
+
+        // Sum of the footprints of the running tasks.
+        [[nodiscard]] bytes reserved() const
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return bytes(reserved_bytes);
+        }
+
+        [[nodiscard]] std::size_t pending_count() const
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return pending.size();
+        }
+
+        void wait_idle()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            idle.wait(lock, [this]() { return pending.empty() && running == 0; });
+        }
+
+        ~memory_aware_executor()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            work_available.notify_all();
+            sample_due.notify_all();
+            for (auto &worker : workers)
+                worker.join();
+        }
+
+    private:
+        struct task {
+            std::function<void()> run;
+            std::uint64_t charge;
+            std::uint64_t declared;
+            std::string kind;
+        };
+
+        // Growth attributed to a running task since it started.
+        struct attribution {
+            std::uint64_t charge;
+            double growth;
+            double peak;
+        };
+
+        static constexpr double learning_rate{0.25};
+        static constexpr double minimum_correction() { return 1.0; }
+        static constexpr std::chrono::milliseconds sampling_period() { return std::chrono::milliseconds(1); }
+
+        [[nodiscard]] bool fits(const task &candidate) const
+        {
+            return running == 0 || reserved_bytes + candidate.charge <= budget_bytes;
+        }
+
+        // Returns the next task to start, or pending.end() when none can be admitted yet.
+        std::deque<task>::iterator select()
+        {
+            if (pending.empty())
+                return pending.end();
+            if (fits(pending.front())) {
+                bypassed = 0;
+                return pending.begin();
+            }
+            if (bypassed >= max_bypass)
+                return pending.end(); // Drain until the head of the queue fits
+            const auto it{std::find_if(pending.begin() + 1, pending.end(),
+                                       [this](const task &candidate) { return fits(candidate); })};
+            if (it != pending.end())
+                ++bypassed;
+            return it;
+        }
+
+        void learn(const task &finished, const double observed)
+        {
+            if (finished.kind.empty() || finished.declared == 0)
+                return;
+            const auto ratio{std::max(observed / static_cast<double>(finished.declared), minimum_correction())};
+            auto it{corrections.find(finished.kind)};
+            if (it == corrections.end())
+                corrections.emplace(finished.kind, ratio);
+            else
+                it->second += learning_rate * (ratio - it->second);
+        }
+
+        void work()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true) {
+                auto next{pending.end()};
+                work_available.wait(lock, [this, &next]() {
+                    next = select();
+                    return next != pending.end() || (stopping && pending.empty());
+                });
+                if (next == pending.end())
+                    return;
+                auto current{std::move(*next)};
+                pending.erase(next);
+                reserved_bytes += current.charge;
+                ++running;
+                const auto id{++started};
+                if (running == 1)
+                    sample_due.notify_one();
+                lock.unlock();
+
+                // The growth up to now belongs to the tasks already running
+                if (probe) {
+                    observe();
+                    lock.lock();
+                    attributions.emplace(id, attribution{current.charge, 0, 0});
+                    lock.unlock();
+                }
+                current.run();
+                if (probe)
+                    observe();
+
+                lock.lock();
+                reserved_bytes -= current.charge;
+                --running;
+                if (probe) {
+                    const auto it{attributions.find(id)};
+                    learn(current, it->second.peak);
+                    attributions.erase(it);
+                }
+                work_available.notify_all();
+                if (pending.empty() && running == 0)
+                    idle.notify_all();
+            }
+        }
+
+        // Splits the growth of the probe since its previous value between the running tasks, in proportion to
+        // their charge.
+        void attribute(const std::uint64_t value)
+        {
+            if (probed && !attributions.empty()) {
+                const auto growth{static_cast<double>(value) - static_cast<double>(last_probe)};
+                double total_charge{0};
+                for (const auto &entry : attributions)
+                    total_charge += static_cast<double>(entry.second.charge);
+                for (auto &entry : attributions) {
+                    auto &running_task{entry.second};
+                    const auto share{total_charge > 0 ? static_cast<double>(running_task.charge) / total_charge
+                                                      : 1.0 / static_cast<double>(attributions.size())};
+                    running_task.growth += growth * share;
+                    running_task.peak = std::max(running_task.peak, running_task.growth);
+                }
+            }
+            last_probe = value;
+            probed = true;
+        }
+
+        // Reads the probe and attributes its growth. The probe has a lock of its own, so that the values are
+        // attributed in the order they were read without holding the executor lock while reading.
+        void observe()
+        {
+            std::lock_guard<std::mutex> probing(probe_mutex);
+            const auto value{probe().count()};
+            std::lock_guard<std::mutex> lock(mutex);
+            attribute(value);
+        }
+
+        // Samples the probe while tasks run, and sleeps otherwise.
+        void sample()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true) {
+                sample_due.wait(lock, [this]() { return stopping || running != 0; });
+                sample_due.wait_for(lock, sampling_period(), [this]() { return stopping; });
+                if (stopping)
+                    return;
+                if (running == 0)
+                    continue;
+                lock.unlock();
+                observe();
+                lock.lock();
+            }
+        }
+
+        const std::uint64_t budget_bytes;
+        memory_probe probe;
+        const std::size_t max_bypass;
+        mutable std::mutex mutex;
+        std::mutex probe_mutex;
+        std::condition_variable work_available;
+        std::condition_variable idle;
+        std::condition_variable sample_due;
+        std::deque<task> pending;
+        std::unordered_map<std::string, double> corrections;
+        std::unordered_map<std::uint64_t, attribution> attributions;
+        std::uint64_t reserved_bytes{0};
+        std::size_t running{0};
+        std::size_t bypassed{0};
+        std::uint64_t started{0};
+        std::uint64_t last_probe{0};
+        bool probed{false};
+        bool stopping{false};
+        std::vector<std::thread> workers;
+    };
+} // namespace mu
+
+#endif // MEMORY_UNITS_EXECUTOR_HPP
@@ -0,0 +1,263 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#ifndef MEMORY_UNITS_EXTERNAL_SORT_HPP
+#define MEMORY_UNITS_EXTERNAL_SORT_HPP
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "memory_units_posix.hpp"
+
+namespace mu
+{
+    namespace details
+    {
+        struct sorted_run {
+            std::uint64_t offset; // In bytes from the beginning of the spill file
+            std::uint64_t count;
+        };
+
+        // Sequential reader of a sorted run. Each refill is a single large read, and the kernel is asked to start
+        // fetching the following chunk right away so that the disk works while the merge consumes the buffer.
+        template<typename T>
+        class run_reader {
+        public:
+            run_reader(const file_descriptor &file, const sorted_run &run, const std::size_t buffer_elements) :
+                file(&file), offset(run.offset), remaining(run.count), buffer(buffer_elements)
+            {
+                refill();
+            }
+
+            [[nodiscard]] bool exhausted() const { return position == filled; }
+
+            [[nodiscard]] const T &front() const { return buffer[position]; }
+
+            void advance()
+            {
+                if (++position == filled)
+                    refill();
+            }
+
+        private:
+            void refill()
+            {
+                const auto count{static_cast<std::size_t>(std::min<std::uint64_t>(remaining, buffer.size()))};
+                const auto size{count * sizeof(T)};
+                if (read_from(*file, reinterpret_cast<char *>(buffer.data()), size, offset) != size)
+                    throw std::runtime_error("A sorted run of the external sort is truncated");
+                offset += size;
+                remaining -= count;
+                position = 0;
+                filled = count;
+#if defined(POSIX_FADV_WILLNEED)
+                if (remaining > 0)
+                    ::posix_fadvise(file->get(), static_cast<off_t>(offset),
+                                    static_cast<off_t>(std::min<std::uint64_t>(remaining, buffer.size()) * sizeof(T)),
+                                    POSIX_FADV_WILLNEED);
+#endif
+            }
+
+            const file_descriptor *file;
+            std::uint64_t offset;
+            std::uint64_t remaining;
+            std::vector<T> buffer;
+            std::size_t position{0};
+            std::size_t filled{0};
+        };
+
+        // Tournament tree of losers: every internal node keeps the loser of the match played there, so replacing
+        // the winner only replays the matches along the path from its leaf to the root, with one comparison per
+        // level instead of the two of a binary heap.
+        template<typename T, typename Compare>
+        class loser_tree {
+        public:
+            loser_tree(std::vector<run_reader<T>> &sources, Compare compare) :
+                sources(sources), compare(std::move(compare)), nodes(sources.size(), sources.size())
+            {
+                // Every node initially holds a virtual source beating all the others, which the real sources push
+                // out while being inserted.
+                for (auto leaf{sources.size()}; leaf-- > 0;)
+                    replay(leaf);
+            }
+
+            [[nodiscard]] bool empty() const { return sources[nodes[0]].exhausted(); }
+
+            [[nodiscard]] const T &top() const { return sources[nodes[0]].front(); }
+
+            void pop()
+            {
+                const auto winner{nodes[0]};
+                sources[winner].advance();
+                replay(winner);
+            }
+
+        private:
+            [[nodiscard]] bool beats(const std::size_t lhs, const std::size_t rhs) const
+            {
+                if (lhs == sources.size())
+                    return true;
+                if (rhs == sources.size())
+                    return false;
+                if (sources[lhs].exhausted())
+                    return false;
+                if (sources[rhs].exhausted())
+                    return true;
+                if (compare(sources[lhs].front(), sources[rhs].front()))
+                    return true;
+                return !compare(sources[rhs].front(), sources[lhs].front()) && lhs < rhs;
+            }
+
+            void replay(std::size_t winner)
+            {
+                for (auto node{(winner + sources.size()) / 2}; node > 0; node /= 2)
+                    if (beats(nodes[node], winner))
+                        std::swap(nodes[node], winner);
+                nodes[0] = winner;
+            }
+
+            std::vector<run_reader<T>> &sources;
+            Compare compare;
+            std::vector<std::size_t> nodes;
+        };
+
+        template<typename T, typename Compare, typename Sink>
+        void merge_runs(const file_descriptor &file, const sorted_run *const runs, const std::size_t count,
+                        const std::size_t buffer_elements, const Compare &compare, Sink sink)
+        {
+            std::vector<run_reader<T>> sources;
+            sources.reserve(count);
+            for (std::size_t i{0}; i < count; ++i)
+                sources.emplace_back(file, runs[i], buffer_elements);
+            loser_tree<T, Compare> tree(sources, compare);
+            for (; !tree.empty(); tree.pop())
+                sink(tree.top());
+        }
+
+        template<typename T>
+        void spill(const file_descriptor &file, const T *const data, const std::size_t count)
+        {
+            write_all(file, reinterpret_cast<const char *>(data), count * sizeof(T));
+        }
+    } // namespace details
+
+    // Sorts a sequence that may be larger than the memory, using at most about a budget of memory for the elements.
+    // Runs filling the budget are sorted in memory and spilled to an anonymous file of the temporary directory,
+    // then merged back with a tournament tree in as many passes as needed by the number of read buffers the budget
+    // can hold. When the whole sequence fits in the budget, it is sorted without touching the disk.
+    template<typename InputIt, typename OutputIt, typename Rep, typename Factor, typename Compare>
+    OutputIt external_sort(InputIt first, const InputIt last, OutputIt out, const memory_size<Rep, Factor> &budget,
+                           const std::string &temporary_directory, Compare compare)
+    {
+        using value_type = typename std::iterator_traits<InputIt>::value_type;
+        static_assert(std::is_trivially_copyable<value_type>::value,
+                      "The external sort spills the elements as raw bytes, they must be trivially copyable");
+        constexpr std::uint64_t merge_buffer_size{1 << 20};
+        constexpr std::size_t min_elements{16};
+
+        const auto budget_bytes{memory_size_cast<bytes>(budget).count()};
+        const auto run_elements{static_cast<std::size_t>(budget_bytes / sizeof(value_type))};
+        if (run_elements < min_elements)
+            throw std::invalid_argument("The memory budget of the external sort is too small");
+        const auto fan_in{static_cast<std::size_t>(
+                std::min<std::uint64_t>(std::max<std::uint64_t>(budget_bytes / merge_buffer_size, 3) - 1,
+                                        run_elements / 2))};
+
+        std::vector<value_type> run;
+        details::file_descriptor file;
+        std::vector<details::sorted_run> runs;
+        std::uint64_t spilled{0};
+        while (first != last) {
+            // Grow geometrically rather than reserving the whole budget, so that small inputs stay cheap.
+            if (run.size() == run.capacity())
+                run.reserve(std::min(run_elements, std::max<std::size_t>(2 * run.capacity(), 4096)));
+            run.push_back(*first);
+            ++first;
+            if (run.size() < run_elements)
+                continue;
+            std::sort(run.begin(), run.end(), compare);
+            if (!file.valid())
+                file = details::create_temporary_file(temporary_directory);
+            details::spill(file, run.data(), run.size());
+            runs.push_back(details::sorted_run{spilled, run.size()});
+            spilled += run.size() * sizeof(value_type);
+            run.clear();
+        }
+        std::sort(run.begin(), run.end(), compare);
+        if (runs.empty())
+            return std::copy(run.begin(), run.end(), out);
+        if (!run.empty()) {
+            details::spill(file, run.data(), run.size());
+            runs.push_back(details::sorted_run{spilled, run.size()});
+        }
+        std::vector<value_type>().swap(run);
+
+        while (runs.size() > fan_in) {
+            // Intermediate pass: groups of runs are merged into longer runs of a new spill file, through a write
+            // buffer as large as one of the read buffers.
+            const auto buffer_elements{run_elements / (fan_in + 1)};
+            auto next_file{details::create_temporary_file(temporary_directory)};
+            std::vector<details::sorted_run> next_runs;
+            std::vector<value_type> pending;
+            pending.reserve(buffer_elements);
+            std::uint64_t written{0};
+            for (std::size_t group{0}; group < runs.size(); group += fan_in) {
+                const auto count{std::min(fan_in, runs.size() - group)};
+                std::uint64_t merged{0};
+                details::merge_runs<value_type>(file, runs.data() + group, count, buffer_elements, compare,
+                                                [&](const value_type &value) {
+                                                    pending.push_back(value);
+                                                    if (pending.size() == buffer_elements) {
+                                                        details::spill(next_file, pending.data(), pending.size());
+                                                        pending.clear();
+                                                    }
+                                                    ++merged;
+                                                });
+                details::spill(next_file, pending.data(), pending.size());
+                pending.clear();
+                next_runs.push_back(details::sorted_run{written, merged});
+                written += merged * sizeof(value_type);
+            }
+            file = std::move(next_file);
+            runs.swap(next_runs);
+        }
+        details::merge_runs<value_type>(file, runs.data(), runs.size(), run_elements / runs.size(), compare,
+                                        [&out](const value_type &value) {
+                                            *out = value;
+                                            ++out;
+                                        });
+        return out;
+    }
+
+    template<typename InputIt, typename OutputIt, typename Rep, typename Factor>
+    OutputIt external_sort(InputIt first, const InputIt last, OutputIt out, const memory_size<Rep, Factor> &budget,
+                           const std::string &temporary_directory = "/tmp")
+    {
+        return external_sort(first, last, out, budget, temporary_directory,
+                             std::less<typename std::iterator_traits<InputIt>::value_type>());
+    }
+} // namespace mu
+
+#endif // MEMORY_UNITS_EXTERNAL_SORT_HPP
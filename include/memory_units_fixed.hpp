@@ -0,0 +1,348 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#ifndef MEMORY_UNITS_FIXED_HPP
+#define MEMORY_UNITS_FIXED_HPP
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ratio>
+#include <type_traits>
+#include "memory_units.hpp"
+#include "memory_units_size_vector.hpp"
+
+namespace mu
+{
+    template<unsigned IntBits, unsigned FracBits>
+    class fixed;
+
+    namespace details
+    {
+#if defined(__SIZEOF_INT128__)
+        __extension__ using wide_int = __int128;
+#endif
+
+        constexpr std::uint64_t magnitude(const std::int64_t value)
+        {
+            return value < 0 ? 0 - static_cast<std::uint64_t>(value) : static_cast<std::uint64_t>(value);
+        }
+
+        // Truncated value * numerator / denominator on a 128-bit intermediate made of two 64-bit halves: the product
+        // of the magnitudes is computed from their 32-bit halves, then divided bit by bit. The quotient must fit in
+        // 64 bits.
+        constexpr std::int64_t portable_multiply_divide(const std::int64_t value, const std::int64_t numerator,
+                                                        const std::int64_t denominator)
+        {
+            constexpr std::uint64_t low_half{0xffffffff};
+            const auto lhs{magnitude(value)};
+            const auto rhs{magnitude(numerator)};
+            const auto divisor{magnitude(denominator)};
+            const auto low{(lhs & low_half) * (rhs & low_half)};
+            const auto middle{(lhs >> 32) * (rhs & low_half)};
+            const auto other_middle{(lhs & low_half) * (rhs >> 32)};
+            const auto cross{(low >> 32) + (middle & low_half) + (other_middle & low_half)};
+            const std::uint64_t product[2]{(lhs >> 32) * (rhs >> 32) + (middle >> 32) + (other_middle >> 32) +
+                                                   (cross >> 32),
+                                           (cross << 32) | (low & low_half)};
+            std::uint64_t quotient{0};
+            std::uint64_t remainder{0};
+            for (unsigned bit{128}; bit-- > 0;) {
+                const auto overflows{(remainder >> 63) != 0};
+                remainder = (remainder << 1) | ((product[bit < 64 ? 1 : 0] >> (bit % 64)) & 1);
+                quotient <<= 1;
+                if (overflows || remainder >= divisor) {
+                    remainder -= divisor;
+                    quotient |= 1;
+                }
+            }
+            const auto negative{((value < 0) != (numerator < 0)) != (denominator < 0)};
+            return static_cast<std::int64_t>(negative ? 0 - quotient : quotient);
+        }
+
+        constexpr std::int64_t multiply_divide_wide(const std::int64_t value, const std::int64_t numerator,
+                                                    const std::int64_t denominator)
+        {
+#if defined(__SIZEOF_INT128__)
+            return static_cast<std::int64_t>(wide_int{value} * numerator / denominator);
+#else
+            return portable_multiply_divide(value, numerator, denominator);
+#endif
+        }
+
+        template<typename>
+        struct is_fixed : std::false_type {};
+
+        template<unsigned IntBits, unsigned FracBits>
+        struct is_fixed<fixed<IntBits, FracBits>> : std::true_type {};
+
+        // Changes the number of fractional bits of a raw fixed-point value, truncating toward zero.
+        template<unsigned To, unsigned From>
+        constexpr std::int64_t rescale(const std::int64_t raw)
+        {
+            return To >= From ? raw * (std::int64_t{1} << (To >= From ? To - From : 0))
+                              : raw / (std::int64_t{1} << (To >= From ? 0 : From - To));
+        }
+    } // namespace details
+
+    // Signed fixed-point number with IntBits integral bits, sign included, and FracBits fractional bits, usable as
+    // the representation of a memory size, e.g. memory_size<mu::fixed<48, 16>, details::gb>. Additions are exact
+    // and associative integer additions; multiplications and divisions go through a 128-bit intermediate, native
+    // when the compiler has one, and truncate toward zero like integers do.
+    template<unsigned IntBits, unsigned FracBits>
+    class fixed {
+        static_assert(IntBits > 0 && FracBits < 63 && IntBits + FracBits <= 64,
+                      "A fixed-point number holds on 64 bits");
+
+    public:
+        using raw_type = std::int64_t;
+
+        static constexpr unsigned integral_bits{IntBits};
+        static constexpr unsigned fractional_bits{FracBits};
+        static constexpr raw_type one{raw_type{1} << FracBits};
+
+        constexpr fixed() = default;
+
+        template<typename T, details::Precondition<std::is_integral<T>::value, int> = 0>
+        constexpr fixed(const T value) : value(static_cast<raw_type>(value) * one)
+        {
+        }
+
+        // Rounds to the nearest representable value.
+        template<typename T, details::Precondition<std::is_floating_point<T>::value, int> = 0>
+        constexpr explicit fixed(const T value) :
+            value(static_cast<raw_type>(value * static_cast<T>(one) + (value < 0 ? T(-0.5) : T(0.5))))
+        {
+        }
+
+        template<unsigned OtherIntBits, unsigned OtherFracBits>
+        constexpr explicit fixed(const fixed<OtherIntBits, OtherFracBits> &other) :
+            value(details::rescale<FracBits, OtherFracBits>(other.raw()))
+        {
+        }
+
+        [[nodiscard]] static constexpr fixed from_raw(const raw_type raw)
+        {
+            fixed result;
+            result.value = raw;
+            return result;
+        }
+
+        [[nodiscard]] constexpr raw_type raw() const { return value; }
+
+        template<typename T, details::Precondition<std::is_integral<T>::value, int> = 0>
+        constexpr explicit operator T() const
+        {
+            return static_cast<T>(value / one);
+        }
+
+        template<typename T, details::Precondition<std::is_floating_point<T>::value, int> = 0>
+        constexpr explicit operator T() const
+        {
+            return static_cast<T>(value) / static_cast<T>(one);
+        }
+
+        constexpr fixed operator+() const { return *this; }
+
+        constexpr fixed operator-() const { return from_raw(-value); }
+
+        constexpr fixed &operator+=(const fixed &other)
+        {
+            value += other.value;
+            return *this;
+        }
+
+        constexpr fixed &operator-=(const fixed &other)
+        {
+            value -= other.value;
+            return *this;
+        }
+
+        constexpr fixed &operator*=(const fixed &other) { return *this = *this * other; }
+
+        constexpr fixed &operator/=(const fixed &other) { return *this = *this / other; }
+
+        friend constexpr fixed operator+(const fixed &lhs, const fixed &rhs) { return from_raw(lhs.value + rhs.value); }
+
+        friend constexpr fixed operator-(const fixed &lhs, const fixed &rhs) { return from_raw(lhs.value - rhs.value); }
+
+        friend constexpr fixed operator*(const fixed &lhs, const fixed &rhs)
+        {
+            return from_raw(details::multiply_divide_wide(lhs.value, rhs.value, one));
+        }
+
+        friend constexpr fixed operator/(const fixed &lhs, const fixed &rhs)
+        {
+            return from_raw(details::multiply_divide_wide(lhs.value, one, rhs.value));
+        }
+
+        friend constexpr bool operator==(const fixed &lhs, const fixed &rhs) { return lhs.value == rhs.value; }
+
+        friend constexpr bool operator!=(const fixed &lhs, const fixed &rhs) { return lhs.value != rhs.value; }
+
+        friend constexpr bool operator<(const fixed &lhs, const fixed &rhs) { return lhs.value < rhs.value; }
+
+        friend constexpr bool operator<=(const fixed &lhs, const fixed &rhs) { return lhs.value <= rhs.value; }
+
+        friend constexpr bool operator>(const fixed &lhs, const fixed &rhs) { return lhs.value > rhs.value; }
+
+        friend constexpr bool operator>=(const fixed &lhs, const fixed &rhs) { return lhs.value >= rhs.value; }
+
+    private:
+        raw_type value{0};
+    };
+
+    template<unsigned IntBits, unsigned FracBits>
+    constexpr typename fixed<IntBits, FracBits>::raw_type fixed<IntBits, FracBits>::one;
+
+    namespace details
+    {
+        // Conversions between units of fixed-point sizes scale the raw value with integer operations only: a
+        // multiplication or a division by a constant, and a 128-bit intermediate when the factor has both.
+        template<typename CommonFactor>
+        constexpr std::int64_t scale_raw(const std::int64_t raw)
+        {
+            return CommonFactor::den == 1   ? raw * static_cast<std::int64_t>(CommonFactor::num)
+                   : CommonFactor::num == 1 ? raw / static_cast<std::int64_t>(CommonFactor::den)
+                                            : multiply_divide_wide(raw, CommonFactor::num, CommonFactor::den);
+        }
+
+        template<typename To, typename CommonFactor, typename CommonFixed>
+        struct fixed_cast {
+            template<typename Rep, typename Factor>
+            static constexpr To cast(const memory_size<Rep, Factor> &from)
+            {
+                using to_rep = typename To::rep;
+                const auto raw{static_cast<CommonFixed>(from.count()).raw()};
+                return To(static_cast<to_rep>(CommonFixed::from_raw(scale_raw<CommonFactor>(raw))));
+            }
+        };
+
+        template<typename To, typename CommonFactor, unsigned IntBits, unsigned FracBits>
+        struct memory_size_cast_impl<To, CommonFactor, fixed<IntBits, FracBits>, false, false>
+            : fixed_cast<To, CommonFactor, fixed<IntBits, FracBits>> {};
+
+        template<typename To, typename CommonFactor, unsigned IntBits, unsigned FracBits>
+        struct memory_size_cast_impl<To, CommonFactor, fixed<IntBits, FracBits>, true, false>
+            : fixed_cast<To, CommonFactor, fixed<IntBits, FracBits>> {};
+
+        template<typename To, typename CommonFactor, unsigned IntBits, unsigned FracBits>
+        struct memory_size_cast_impl<To, CommonFactor, fixed<IntBits, FracBits>, false, true>
+            : fixed_cast<To, CommonFactor, fixed<IntBits, FracBits>> {};
+
+        template<typename To, typename CommonFactor, unsigned IntBits, unsigned FracBits>
+        struct memory_size_cast_impl<To, CommonFactor, fixed<IntBits, FracBits>, true, true>
+            : fixed_cast<To, CommonFactor, fixed<IntBits, FracBits>> {};
+
+        template<typename Fixed, typename Other, bool = std::is_integral<Other>::value,
+                 bool = std::is_floating_point<Other>::value>
+        struct fixed_common_type {};
+
+        template<typename Fixed, typename Other>
+        struct fixed_common_type<Fixed, Other, true, false> : identity<Fixed> {};
+
+        template<typename Fixed, typename Other>
+        struct fixed_common_type<Fixed, Other, false, true> : identity<Other> {};
+
+        template<typename Factor, typename ToFactor, unsigned IntBits, unsigned FracBits>
+        void scale_fixed(const fixed<IntBits, FracBits> *first, const fixed<IntBits, FracBits> *const last,
+                         fixed<IntBits, FracBits> *out)
+        {
+            using common_factor = typename std::ratio_divide<Factor, ToFactor>::type;
+            for (; first != last; ++first, ++out)
+                *out = fixed<IntBits, FracBits>::from_raw(scale_raw<common_factor>(first->raw()));
+        }
+
+        template<unsigned IntBits, unsigned FracBits>
+        std::int64_t sum_raw(const fixed<IntBits, FracBits> *first, const fixed<IntBits, FracBits> *const last)
+        {
+            std::int64_t total{0};
+            for (; first != last; ++first)
+                total += first->raw();
+            return total;
+        }
+    } // namespace details
+
+    // Batch variants over the contiguous counts of a size_vector, whose loops only add or scale the raw 64-bit
+    // integers, without branches nor floating point, and can be vectorized.
+    template<typename Factor, unsigned IntBits, unsigned FracBits>
+    memory_size<fixed<IntBits, FracBits>, Factor> sum(const size_vector<Factor, fixed<IntBits, FracBits>> &sizes)
+    {
+        return memory_size<fixed<IntBits, FracBits>, Factor>(fixed<IntBits, FracBits>::from_raw(
+                details::sum_raw(sizes.data(), sizes.data() + sizes.size())));
+    }
+
+    // Converts every size to the unit of To, truncating like memory_size_cast. To keeps the representation.
+    template<typename To, typename Factor, unsigned IntBits, unsigned FracBits>
+    details::Precondition<details::is_memory_size<To>::value &&
+                                  std::is_same<typename To::rep, fixed<IntBits, FracBits>>::value,
+                          size_vector<typename To::factor, fixed<IntBits, FracBits>>>
+    memory_size_cast(const size_vector<Factor, fixed<IntBits, FracBits>> &from)
+    {
+        size_vector<typename To::factor, fixed<IntBits, FracBits>> to(from.size());
+        details::scale_fixed<Factor, typename To::factor>(from.data(), from.data() + from.size(), to.data());
+        return to;
+    }
+} // namespace mu
+
+namespace std
+{
+    // The common type of two fixed-point numbers keeps the finer fraction, and as many integral bits as fit.
+    template<unsigned IntBits, unsigned FracBits, unsigned OtherIntBits, unsigned OtherFracBits>
+    struct common_type<mu::fixed<IntBits, FracBits>, mu::fixed<OtherIntBits, OtherFracBits>> {
+    private:
+        static constexpr unsigned frac_bits{FracBits > OtherFracBits ? FracBits : OtherFracBits};
+        static constexpr unsigned int_bits{IntBits > OtherIntBits ? IntBits : OtherIntBits};
+
+    public:
+        using type = mu::fixed<(int_bits + frac_bits > 64 ? 64 - frac_bits : int_bits), frac_bits>;
+    };
+
+    // Integers convert to fixed-point numbers, and fixed-point numbers to floating point numbers.
+    template<unsigned IntBits, unsigned FracBits, typename Other>
+    struct common_type<mu::fixed<IntBits, FracBits>, Other>
+        : mu::details::fixed_common_type<mu::fixed<IntBits, FracBits>, Other> {};
+
+    template<typename Other, unsigned IntBits, unsigned FracBits>
+    struct common_type<Other, mu::fixed<IntBits, FracBits>>
+        : mu::details::fixed_common_type<mu::fixed<IntBits, FracBits>, Other> {};
+
+    template<unsigned IntBits, unsigned FracBits>
+    class numeric_limits<mu::fixed<IntBits, FracBits>> {
+        using type = mu::fixed<IntBits, FracBits>;
+        static constexpr std::int64_t largest{
+                static_cast<std::int64_t>((std::uint64_t{1} << (IntBits + FracBits - 1)) - 1)};
+
+    public:
+        static constexpr bool is_specialized{true};
+        static constexpr bool is_signed{true};
+        static constexpr bool is_integer{false};
+        static constexpr bool is_exact{true};
+
+        static constexpr type min() noexcept { return type::from_raw(1); }
+
+        static constexpr type lowest() noexcept { return type::from_raw(-largest - 1); }
+
+        static constexpr type max() noexcept { return type::from_raw(largest); }
+
+        static constexpr type epsilon() noexcept { return type::from_raw(1); }
+    };
+} // namespace std
+
+#endif // MEMORY_UNITS_FIXED_HPP
@@ -0,0 +1,382 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#ifndef MEMORY_UNITS_LAYOUT_HPP
+#define MEMORY_UNITS_LAYOUT_HPP
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#if __cplusplus >= 201703L
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#endif
+#include "memory_units.hpp"
+
+// Describes a data member of a standard-layout type for mu::layout_of, e.g. MU_FIELD(counters, reads).
+#define MU_FIELD(Type, member)                                                                                         \
+    ::mu::field_layout { #member, ::mu::bytes(offsetof(Type, member)), ::mu::bytes(sizeof(Type::member)) }
+
+namespace mu
+{
+    template<typename T>
+    constexpr bytes size_of{sizeof(T)};
+
+    template<typename T>
+    constexpr bytes align_of{alignof(T)};
+
+    // Whether an object of type T fits in a number of units, e.g. fits_in<counters, cache_lines>(1).
+    template<typename T, typename Unit>
+    constexpr bool fits_in(const typename Unit::rep count)
+    {
+        return size_of<T> <= Unit(count);
+    }
+
+    // Largest number of units an object of type T can touch, given that its address is only guaranteed to be a
+    // multiple of its alignment, e.g. units_touched<std::uint64_t[8], cache_lines>() == 2.
+    template<typename T, typename Unit>
+    constexpr Unit units_touched()
+    {
+        constexpr auto unit{memory_size_cast<bytes>(Unit(1)).count()};
+        constexpr auto alignment{alignof(T)};
+        constexpr auto granularity{alignment % unit == 0 ? unit : details::static_gcd<alignment, unit>::value};
+        return Unit((unit - granularity + sizeof(T) - 1) / unit + 1);
+    }
+
+    namespace details
+    {
+        template<std::size_t Bytes>
+        struct size_in_bytes {};
+
+        template<std::size_t Bytes>
+        struct limit_in_bytes {};
+
+        // Instantiated with the sizes as types, so that they appear in the diagnostic when the check fails.
+        template<typename T, typename Size, typename Limit, bool Fits>
+        struct layout_check : std::true_type {
+            static_assert(Fits, "The type exceeds its size limit, see the size_in_bytes and limit_in_bytes above");
+        };
+    } // namespace details
+
+    // Fails to compile when an object of type T does not fit in Count units, naming both sizes in bytes, e.g.
+    // static_assert(mu::assert_fits_in<counters, mu::cache_lines, 1>::value, "").
+    template<typename T, typename Unit, typename Unit::rep Count>
+    struct assert_fits_in
+        : details::layout_check<T, details::size_in_bytes<sizeof(T)>,
+                                details::limit_in_bytes<memory_size_cast<bytes>(Unit(Count)).count()>,
+                                (sizeof(T) <= memory_size_cast<bytes>(Unit(Count)).count())> {};
+
+    struct field_layout {
+        const char *name{""};
+        bytes offset{};
+        bytes size{};
+
+        [[nodiscard]] constexpr bytes end() const { return offset + size; }
+    };
+
+    // Layout of a type described by a list of its fields: the padding around them and the cache lines they lie
+    // on, usable in static assertions. Cache lines are counted from the start of the object, which is only the
+    // actual placement when the type is aligned on a cache line.
+    template<typename T, std::size_t N>
+    class layout_report {
+    public:
+        template<typename... Fields>
+        constexpr explicit layout_report(const Fields &...layouts) : fields{layouts...}
+        {
+            for (std::size_t i{1}; i < N; ++i)
+                for (std::size_t j{i}; j > 0 && fields[j].offset < fields[j - 1].offset; --j) {
+                    const auto field{fields[j]};
+                    fields[j] = fields[j - 1];
+                    fields[j - 1] = field;
+                }
+        }
+
+        [[nodiscard]] constexpr bytes size() const { return size_of<T>; }
+
+        [[nodiscard]] constexpr bytes alignment() const { return align_of<T>; }
+
+        [[nodiscard]] static constexpr std::size_t field_count() { return N; }
+
+        // Fields are sorted by offset.
+        [[nodiscard]] constexpr const field_layout &field(const std::size_t index) const { return fields[index]; }
+
+        // Throws std::invalid_argument for an unknown name, which fails to compile in a constant expression.
+        [[nodiscard]] constexpr std::size_t index_of(const char *const name) const
+        {
+            for (std::size_t i{0}; i < N; ++i)
+                if (equal(fields[i].name, name))
+                    return i;
+            throw std::invalid_argument("No field named " + std::string(name));
+        }
+
+        [[nodiscard]] constexpr bytes padding_before(const std::size_t index) const
+        {
+            return fields[index].offset - (index == 0 ? bytes(0) : fields[index - 1].end());
+        }
+
+        [[nodiscard]] constexpr bytes internal_padding() const
+        {
+            bytes padding{0};
+            for (std::size_t i{0}; i < N; ++i)
+                padding += padding_before(i);
+            return padding;
+        }
+
+        [[nodiscard]] constexpr bytes tail_padding() const
+        {
+            return size() - (N == 0 ? bytes(0) : fields[N - 1].end());
+        }
+
+        [[nodiscard]] constexpr bytes padding() const { return internal_padding() + tail_padding(); }
+
+        [[nodiscard]] constexpr cache_lines cache_line_count() const { return ceil<cache_lines>(size()); }
+
+        [[nodiscard]] constexpr std::uint64_t first_cache_line(const std::size_t index) const
+        {
+            return floor<cache_lines>(fields[index].offset).count();
+        }
+
+        [[nodiscard]] constexpr std::uint64_t last_cache_line(const std::size_t index) const
+        {
+            return floor<cache_lines>(fields[index].end() - bytes(fields[index].size != bytes(0) ? 1 : 0)).count();
+        }
+
+        [[nodiscard]] constexpr bool straddles_cache_line(const std::size_t index) const
+        {
+            return first_cache_line(index) != last_cache_line(index);
+        }
+
+        // Whether two fields lie on a common cache line, causing false sharing when different threads write them.
+        [[nodiscard]] constexpr bool share_cache_line(const std::size_t index, const std::size_t other) const
+        {
+            return first_cache_line(index) <= last_cache_line(other) &&
+                   first_cache_line(other) <= last_cache_line(index);
+        }
+
+        [[nodiscard]] constexpr bool share_cache_line(const char *const name, const char *const other) const
+        {
+            return share_cache_line(index_of(name), index_of(other));
+        }
+
+        // One line per field and per hole: offset, size and cache lines, in bytes.
+        [[nodiscard]] std::string describe() const
+        {
+            std::string report;
+            for (std::size_t i{0}; i < N; ++i) {
+                if (padding_before(i) != bytes(0))
+                    report += "  [padding] offset " + std::to_string((fields[i].offset - padding_before(i)).count()) +
+                              " size " + std::to_string(padding_before(i).count()) + "\n";
+                report += "  " + std::string(fields[i].name) + " offset " + std::to_string(fields[i].offset.count()) +
+                          " size " + std::to_string(fields[i].size.count()) + " cache line " +
+                          std::to_string(first_cache_line(i));
+                if (straddles_cache_line(i))
+                    report += "-" + std::to_string(last_cache_line(i));
+                report += "\n";
+            }
+            if (tail_padding() != bytes(0))
+                report += "  [padding] offset " + std::to_string((size() - tail_padding()).count()) + " size " +
+                          std::to_string(tail_padding().count()) + "\n";
+            return "size " + std::to_string(size().count()) + " alignment " + std::to_string(alignment().count()) +
+                   " padding " + std::to_string(padding().count()) + " cache lines " +
+                   std::to_string(cache_line_count().count()) + "\n" + report;
+        }
+
+    private:
+        static constexpr bool equal(const char *lhs, const char *rhs)
+        {
+            for (; *lhs != '\0' && *lhs == *rhs; ++lhs, ++rhs) {
+            }
+            return *lhs == *rhs;
+        }
+
+        field_layout fields[N == 0 ? 1 : N];
+    };
+
+    // Builds the layout report of a type from its fields, given with MU_FIELD in any order, e.g.
+    // constexpr auto layout{mu::layout_of<counters>(MU_FIELD(counters, reads), MU_FIELD(counters, writes))}.
+    template<typename T, typename... Fields>
+    constexpr layout_report<T, sizeof...(Fields)> layout_of(const Fields &...fields)
+    {
+        return layout_report<T, sizeof...(Fields)>(fields...);
+    }
+
+#if __cplusplus >= 201703L
+    namespace details
+    {
+        constexpr std::size_t max_aggregate_members{16};
+
+        // Converts to any type, to count the members of an aggregate by initializing each of them from it.
+        struct any_member {
+            template<typename U>
+            operator U() const;
+        };
+
+        // Converts to any lvalue reference, which only a value cannot do for a non-const reference member.
+        struct any_reference {
+            template<typename U>
+            operator U &() const;
+        };
+
+        // Each member is initialized from its own braces, so that array members count as one.
+        template<typename T, typename Member, typename Indices, typename = void>
+        struct initializable_from : std::false_type {};
+
+        template<typename T, typename Member, std::size_t... Indices>
+        struct initializable_from<T, Member, std::index_sequence<Indices...>,
+                                  std::void_t<decltype(T{{(static_cast<void>(Indices), Member{})}...})>>
+            : std::true_type {};
+
+        // Counts one member past the limit, so that larger aggregates are rejected rather than truncated.
+        template<typename T, typename Member = any_member, std::size_t N = max_aggregate_members + 1>
+        struct member_count
+            : std::conditional_t<initializable_from<T, Member, std::make_index_sequence<N>>::value,
+                                 std::integral_constant<std::size_t, N>, member_count<T, Member, N - 1>> {};
+
+        template<typename T, typename Member>
+        struct member_count<T, Member, 0> : std::integral_constant<std::size_t, 0> {};
+
+        template<typename T>
+        struct enumerable_member_count : member_count<T> {
+            static_assert(member_count<T>::value <= max_aggregate_members,
+                          "Too many members to enumerate, describe the fields with MU_FIELD instead");
+            static_assert(member_count<T, any_reference>::value <= member_count<T>::value,
+                          "Reference members cannot be located, describe the fields with MU_FIELD instead");
+            static_assert(member_count<T>::value != 0 || std::is_empty<T>::value,
+                          "The members cannot be counted, describe the fields with MU_FIELD instead");
+        };
+
+        // The declared types of the members, as seen through the structured binding, tell the reference members
+        // apart: those bind to the object referred to, which lies outside of the aggregate.
+        template<typename... Declared, typename... Members>
+        auto tie_declared(Members &...members)
+        {
+            static_assert((!std::is_reference<Declared>::value && ...),
+                          "Reference members cannot be located, describe the fields with MU_FIELD instead");
+            return std::tie(members...);
+        }
+
+        template<std::size_t N, typename T>
+        auto tie_members(const T &object)
+        {
+            if constexpr (N == 0)
+                return std::tie();
+            else if constexpr (N == 1) {
+                auto &[m0] = object;
+                return tie_declared<decltype(m0)>(m0);
+            }
+            else if constexpr (N == 2) {
+                auto &[m0, m1] = object;
+                return tie_declared<decltype(m0), decltype(m1)>(m0, m1);
+            }
+            else if constexpr (N == 3) {
+                auto &[m0, m1, m2] = object;
+                return tie_declared<decltype(m0), decltype(m1), decltype(m2)>(m0, m1, m2);
+            }
+            else if constexpr (N == 4) {
+                auto &[m0, m1, m2, m3] = object;
+                return tie_declared<decltype(m0), decltype(m1), decltype(m2), decltype(m3)>(m0, m1, m2, m3);
+            }
+            else if constexpr (N == 5) {
+                auto &[m0, m1, m2, m3, m4] = object;
+                return tie_declared<decltype(m0), decltype(m1), decltype(m2), decltype(m3), decltype(m4)>(m0, m1, m2, m3, m4);
+            }
+            else if constexpr (N == 6) {
+                auto &[m0, m1, m2, m3, m4, m5] = object;
+                return tie_declared<decltype(m0), decltype(m1), decltype(m2), decltype(m3), decltype(m4), decltype(m5)>(m0, m1, m2, m3, m4, m5);
+            }
+            else if constexpr (N == 7) {
+                auto &[m0, m1, m2, m3, m4, m5, m6] = object;
+                return tie_declared<decltype(m0), decltype(m1), decltype(m2), decltype(m3), decltype(m4), decltype(m5), decltype(m6)>(m0, m1, m2, m3, m4, m5, m6);
+            }
+            else if constexpr (N == 8) {
+                auto &[m0, m1, m2, m3, m4, m5, m6, m7] = object;
+                return tie_declared<decltype(m0), decltype(m1), decltype(m2), decltype(m3), decltype(m4), decltype(m5), decltype(m6), decltype(m7)>(m0, m1, m2, m3, m4, m5, m6, m7);
+            }
+            else if constexpr (N == 9) {
+                auto &[m0, m1, m2, m3, m4, m5, m6, m7, m8] = object;
+                return tie_declared<decltype(m0), decltype(m1), decltype(m2), decltype(m3), decltype(m4), decltype(m5), decltype(m6), decltype(m7), decltype(m8)>(m0, m1, m2, m3, m4, m5, m6, m7, m8);
+            }
+            else if constexpr (N == 10) {
+                auto &[m0, m1, m2, m3, m4, m5, m6, m7, m8, m9] = object;
+                return tie_declared<decltype(m0), decltype(m1), decltype(m2), decltype(m3), decltype(m4), decltype(m5), decltype(m6), decltype(m7), decltype(m8), decltype(m9)>(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9);
+            }
+            else if constexpr (N == 11) {
+                auto &[m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10] = object;
+                return tie_declared<decltype(m0), decltype(m1), decltype(m2), decltype(m3), decltype(m4), decltype(m5), decltype(m6), decltype(m7), decltype(m8), decltype(m9), decltype(m10)>(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10);
+            }
+            else if constexpr (N == 12) {
+                auto &[m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11] = object;
+                return tie_declared<decltype(m0), decltype(m1), decltype(m2), decltype(m3), decltype(m4), decltype(m5), decltype(m6), decltype(m7), decltype(m8), decltype(m9), decltype(m10), decltype(m11)>(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11);
+            }
+            else if constexpr (N == 13) {
+                auto &[m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12] = object;
+                return tie_declared<decltype(m0), decltype(m1), decltype(m2), decltype(m3), decltype(m4), decltype(m5), decltype(m6), decltype(m7), decltype(m8), decltype(m9), decltype(m10), decltype(m11), decltype(m12)>(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12);
+            }
+            else if constexpr (N == 14) {
+                auto &[m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13] = object;
+                return tie_declared<decltype(m0), decltype(m1), decltype(m2), decltype(m3), decltype(m4), decltype(m5), decltype(m6), decltype(m7), decltype(m8), decltype(m9), decltype(m10), decltype(m11), decltype(m12), decltype(m13)>(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13);
+            }
+            else if constexpr (N == 15) {
+                auto &[m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14] = object;
+                return tie_declared<decltype(m0), decltype(m1), decltype(m2), decltype(m3), decltype(m4), decltype(m5), decltype(m6), decltype(m7), decltype(m8), decltype(m9), decltype(m10), decltype(m11), decltype(m12), decltype(m13), decltype(m14)>(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14);
+            }
+            else if constexpr (N == 16) {
+                auto &[m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15] = object;
+                return tie_declared<decltype(m0), decltype(m1), decltype(m2), decltype(m3), decltype(m4), decltype(m5), decltype(m6), decltype(m7), decltype(m8), decltype(m9), decltype(m10), decltype(m11), decltype(m12), decltype(m13), decltype(m14), decltype(m15)>(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15);
+            }
+        }
+
+        constexpr const char *member_names[max_aggregate_members]{"0", "1", "2",  "3",  "4",  "5",  "6",  "7",
+                                                                  "8", "9", "10", "11", "12", "13", "14", "15"};
+
+        template<typename T, typename Members, std::size_t... Indices>
+        layout_report<T, sizeof...(Indices)> aggregate_layout(const T &object, const Members &members,
+                                                              std::index_sequence<Indices...>)
+        {
+            const auto base{reinterpret_cast<const char *>(&object)};
+            return layout_report<T, sizeof...(Indices)>(field_layout{
+                    member_names[Indices],
+                    bytes(static_cast<std::size_t>(reinterpret_cast<const char *>(&std::get<Indices>(members)) - base)),
+                    bytes(sizeof(std::get<Indices>(members)))}...);
+        }
+    } // namespace details
+
+    // Builds the layout report of an aggregate from its members, enumerated with a structured binding, e.g.
+    // mu::layout_of<counters>(). The language gives no member names, so fields are named after their position in
+    // the declaration: "0", "1"... The aggregate must be default constructible and have at most 16 members, no
+    // base class, no bit-field, no reference and no member of a class constructible from a single value other than
+    // itself, which cannot be counted. The members are located in an object value-initialized once per type. This
+    // is not a constant expression; MU_FIELD remains for static assertions.
+    template<typename T>
+    layout_report<T, details::enumerable_member_count<T>::value> layout_of()
+    {
+        static_assert(std::is_aggregate<T>::value, "Only the members of aggregates can be enumerated");
+        static_assert(std::is_default_constructible<T>::value,
+                      "The members are located in an object, describe the fields with MU_FIELD instead");
+        constexpr auto count{details::enumerable_member_count<T>::value};
+        static const T object{};
+        return details::aggregate_layout(object, details::tie_members<count>(object),
+                                         std::make_index_sequence<count>());
+    }
+#endif
+} // namespace mu
+
+#endif // MEMORY_UNITS_LAYOUT_HPP
@@ -0,0 +1,233 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#ifndef MEMORY_UNITS_MAPPED_REGION_HPP
+#define MEMORY_UNITS_MAPPED_REGION_HPP
+#if !defined(__linux__)
+#error "Mapped regions rely on Linux memory management system calls and are only available on Linux"
+#endif
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include "memory_units_posix.hpp"
+
+namespace mu
+{
+    enum class huge_page_policy {
+        none,        // Base pages only
+        transparent, // 2 MiB aligned region advised with MADV_HUGEPAGE, backed by huge pages when available
+        reserved     // MAP_HUGETLB from the pool of reserved 2 MiB huge pages, fails if the pool is too small
+    };
+
+    enum class prefault_policy {
+        none,     // Pages are faulted in on first access
+        populate, // Faulted in by the kernel while mapping (MAP_POPULATE or MADV_POPULATE_WRITE)
+        touch     // Faulted in by writing every page from several threads
+    };
+
+    enum class numa_policy {
+        local,      // Default policy of the thread faulting the pages in
+        bind,       // Only from the nodes of the mask
+        interleave, // Round-robin over the nodes of the mask
+        preferred   // From the first node of the mask when possible
+    };
+
+    struct mapped_region_options {
+        prefault_policy prefault{prefault_policy::none};
+        unsigned touch_threads{std::thread::hardware_concurrency()};
+        numa_policy numa{numa_policy::local};
+        std::uint64_t numa_nodes{0}; // Mask of the NUMA nodes 0 to 62
+        bool lock{false};            // mlock the region, faulting it in
+    };
+
+    namespace details
+    {
+        constexpr std::size_t huge_page_bytes{huge_pages::factor::num};
+
+        inline std::size_t page_bytes() { return static_cast<std::size_t>(page_size().count()); }
+
+        constexpr std::size_t round_up(const std::size_t size, const std::size_t alignment)
+        {
+            return (size + alignment - 1) & ~(alignment - 1);
+        }
+
+        // Maps an anonymous region aligned on its alignment by over-mapping and trimming both ends, so that
+        // transparent huge pages can back it from its first byte.
+        inline memory_mapping map_aligned(const std::size_t size, const std::size_t alignment, const int flags)
+        {
+            const auto padded{size + alignment - page_bytes()};
+            const auto raw{::mmap(nullptr, padded, PROT_READ | PROT_WRITE, flags, -1, 0)};
+            if (raw == MAP_FAILED)
+                throw std::system_error(errno, std::generic_category(), "Unable to map the region");
+            const auto begin{reinterpret_cast<std::uintptr_t>(raw)};
+            const auto aligned{round_up(begin, alignment)};
+            if (aligned > begin)
+                ::munmap(raw, aligned - begin);
+            const auto tail{padded - (aligned - begin) - size};
+            if (tail > 0)
+                ::munmap(reinterpret_cast<void *>(aligned + size), tail);
+            return memory_mapping(reinterpret_cast<void *>(aligned), size);
+        }
+
+        inline void touch_pages(char *const data, const std::size_t size, const std::size_t stride,
+                                const unsigned thread_count)
+        {
+            const auto pages{size / stride};
+            const auto touch = [data, stride](const std::size_t first, const std::size_t last) {
+                for (auto page{first}; page < last; ++page)
+                    *static_cast<volatile char *>(data + page * stride) = 0;
+            };
+            const auto threads{std::max<std::size_t>(1, std::min<std::size_t>(thread_count, pages / 64))};
+            std::vector<std::thread> workers;
+            for (std::size_t t{1}; t < threads; ++t)
+                workers.emplace_back(touch, pages * t / threads, pages * (t + 1) / threads);
+            touch(0, pages / threads);
+            for (auto &worker : workers)
+                worker.join();
+        }
+    } // namespace details
+
+    // RAII anonymous memory mapping sized from a memory_size, rounded up to whole pages of the size backing it.
+    // The NUMA policy and the huge page advice are applied before any page is faulted in, so that prefaulting
+    // honors both.
+    class mapped_region {
+    public:
+        template<typename Rep, typename Factor>
+        explicit mapped_region(const memory_size<Rep, Factor> &size,
+                               const huge_page_policy policy = huge_page_policy::none,
+                               const mapped_region_options &options = mapped_region_options()) :
+            policy(policy)
+        {
+            const auto requested{memory_size_cast<bytes>(size).count()};
+            if (requested == 0)
+                throw std::invalid_argument("A mapped region cannot be empty");
+            const auto page{policy == huge_page_policy::none ? details::page_bytes() : details::huge_page_bytes};
+            const auto length{details::round_up(static_cast<std::size_t>(requested), page)};
+            const auto advised{policy == huge_page_policy::transparent || options.numa != numa_policy::local};
+            auto flags{MAP_PRIVATE | MAP_ANONYMOUS};
+            // Without a reservation, huge pages missing from the pool or memory missing for a populated or locked
+            // region would only be noticed as a SIGBUS or an OOM kill on first access.
+            if (policy != huge_page_policy::reserved && options.prefault != prefault_policy::populate &&
+                !options.lock)
+                flags |= MAP_NORESERVE;
+            if (options.prefault == prefault_policy::populate && !advised)
+                flags |= MAP_POPULATE;
+
+            if (policy == huge_page_policy::reserved) {
+                flags |= MAP_HUGETLB;
+#if defined(MAP_HUGE_2MB)
+                flags |= MAP_HUGE_2MB;
+#endif
+                const auto address{::mmap(nullptr, length, PROT_READ | PROT_WRITE, flags, -1, 0)};
+                if (address == MAP_FAILED)
+                    throw std::system_error(errno, std::generic_category(), "Unable to map reserved huge pages");
+                mapping = details::memory_mapping(address, length);
+            }
+            else if (policy == huge_page_policy::transparent) {
+                mapping = details::map_aligned(length, details::huge_page_bytes, flags);
+                // The region stays usable with base pages when the kernel rejects the advice, it is then reported
+                // as backed by base pages only.
+                if (::madvise(mapping.get(), length, MADV_HUGEPAGE) != 0)
+                    this->policy = huge_page_policy::none;
+            }
+            else {
+                const auto address{::mmap(nullptr, length, PROT_READ | PROT_WRITE, flags, -1, 0)};
+                if (address == MAP_FAILED)
+                    throw std::system_error(errno, std::generic_category(), "Unable to map the region");
+                mapping = details::memory_mapping(address, length);
+            }
+
+            if (options.numa != numa_policy::local)
+                bind(options.numa, options.numa_nodes);
+            if (options.prefault == prefault_policy::populate && advised)
+                populate(options.touch_threads);
+            else if (options.prefault == prefault_policy::touch)
+                details::touch_pages(data<char>(), length, stride(), options.touch_threads);
+            if (options.lock) {
+                if (::mlock(mapping.get(), length) != 0)
+                    throw std::system_error(errno, std::generic_category(), "Unable to lock the region");
+                locked = true;
+            }
+        }
+
+        mapped_region(mapped_region &&) noexcept = default;
+
+        mapped_region &operator=(mapped_region &&) noexcept = default;
+
+        [[nodiscard]] void *data() const { return mapping.get(); }
+
+        template<typename T>
+        [[nodiscard]] T *data() const
+        {
+            return static_cast<T *>(mapping.get());
+        }
+
+        [[nodiscard]] bytes size() const { return bytes(mapping.size()); }
+
+        // The requested policy, or none when the kernel rejected the transparent huge page advice.
+        [[nodiscard]] huge_page_policy huge_pages_policy() const { return policy; }
+
+        [[nodiscard]] bool is_locked() const { return locked; }
+
+    private:
+        // Transparent huge pages are only advisory and may be backed by base pages, so only the reserved ones
+        // are known to be faulted in whole.
+        [[nodiscard]] std::size_t stride() const
+        {
+            return policy == huge_page_policy::reserved ? details::huge_page_bytes : details::page_bytes();
+        }
+
+        void bind(const numa_policy mode, const std::uint64_t nodes)
+        {
+            static const int modes[]{0, 2, 3, 1}; // MPOL_DEFAULT, MPOL_BIND, MPOL_INTERLEAVE, MPOL_PREFERRED
+            unsigned long mask{static_cast<unsigned long>(nodes)};
+            // The kernel only considers the first maxnode - 1 bits of the mask.
+            if (::syscall(SYS_mbind, mapping.get(), mapping.size(), modes[static_cast<int>(mode)], &mask,
+                          8 * sizeof(mask), 0) != 0)
+                throw std::system_error(errno, std::generic_category(), "Unable to set the NUMA policy");
+        }
+
+        void populate(const unsigned thread_count)
+        {
+#if defined(MADV_POPULATE_WRITE)
+            constexpr int advice{MADV_POPULATE_WRITE};
+#else
+            constexpr int advice{23};
+#endif
+            if (::madvise(mapping.get(), mapping.size(), advice) == 0)
+                return;
+            // Kernels older than 5.14 do not know the advice.
+            details::touch_pages(data<char>(), mapping.size(), stride(), thread_count);
+        }
+
+        details::memory_mapping mapping;
+        huge_page_policy policy;
+        bool locked{false};
+    };
+} // namespace mu
+
+#endif // MEMORY_UNITS_MAPPED_REGION_HPP
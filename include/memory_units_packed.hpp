@@ -0,0 +1,236 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#ifndef MEMORY_UNITS_PACKED_HPP
+#define MEMORY_UNITS_PACKED_HPP
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <ratio>
+#include <type_traits>
+#include "memory_units.hpp"
+
+namespace mu
+{
+    namespace details
+    {
+        constexpr unsigned bit_width(const std::uint64_t value)
+        {
+#if defined(__GNUC__)
+            return value == 0 ? 0 : 64 - static_cast<unsigned>(__builtin_clzll(value));
+#else
+            return value == 0 ? 0 : 1 + bit_width(value >> 1);
+#endif
+        }
+
+        // Little-endian integer on Bits / 8 bytes, byte-aligned so that arrays of it are tightly packed.
+        template<unsigned Bits>
+        struct packed_bytes {
+            unsigned char bytes[Bits / 8];
+        };
+
+        // Native integers hold the codes of 8, 16 and 32 bits, byte arrays hold the other widths.
+        template<unsigned Bits>
+        using packed_code = typename std::conditional<
+                (Bits == 8), std::uint8_t,
+                typename std::conditional<
+                        (Bits == 16), std::uint16_t,
+                        typename std::conditional<(Bits == 32), std::uint32_t, packed_bytes<Bits>>::type>::type>::type;
+
+        template<typename Storage>
+        struct code_access {
+            static constexpr Storage store(const std::uint64_t value) { return static_cast<Storage>(value); }
+
+            static constexpr std::uint64_t load(const Storage code) { return code; }
+        };
+
+        template<unsigned Bits>
+        struct code_access<packed_bytes<Bits>> {
+            static constexpr packed_bytes<Bits> store(const std::uint64_t value)
+            {
+                packed_bytes<Bits> result{};
+                for (unsigned i{0}; i < Bits / 8; ++i)
+                    result.bytes[i] = static_cast<unsigned char>(value >> (8 * i));
+                return result;
+            }
+
+            static constexpr std::uint64_t load(const packed_bytes<Bits> &code)
+            {
+                std::uint64_t value{0};
+                for (unsigned i{0}; i < Bits / 8; ++i)
+                    value |= std::uint64_t{code.bytes[i]} << (8 * i);
+                return value;
+            }
+        };
+
+        // Largest code of a log-scale format with the given mantissa: the largest value it decodes to is the
+        // largest 64-bit value keeping Mantissa + 1 significant bits.
+        constexpr std::uint64_t log_max_code(const unsigned mantissa)
+        {
+            return ((std::uint64_t{65} - mantissa) << mantissa) - 1;
+        }
+
+        constexpr bool log_format_fits(const unsigned bits, const unsigned mantissa)
+        {
+            return mantissa < bits && mantissa < 63 && log_max_code(mantissa) <= (std::uint64_t{1} << bits) - 1;
+        }
+
+        constexpr unsigned finest_mantissa(const unsigned bits, const unsigned mantissa = 1)
+        {
+            return log_format_fits(bits, mantissa + 1) ? finest_mantissa(bits, mantissa + 1) : mantissa;
+        }
+
+        // Smallest mantissa whose rounding error, at most 2^-(mantissa + 1), stays within the bound.
+        template<typename RelativeError>
+        constexpr unsigned mantissa_for(const unsigned mantissa = 1)
+        {
+            return static_cast<std::uint64_t>(RelativeError::num) << (mantissa + 1) >=
+                                   static_cast<std::uint64_t>(RelativeError::den) ||
+                           mantissa >= 62
+                           ? mantissa
+                           : mantissa_for<RelativeError>(mantissa + 1);
+        }
+
+        // Float-like encoding keeping the Mantissa + 1 most significant bits of the value, rounded to nearest.
+        // Values below 2^(Mantissa + 1) are stored as is; above, the code is the shift applied to the value
+        // followed by the significant bits without their implicit leading one. Codes are ordered like the values
+        // they encode and both directions are branch-free, so bulk loops can be vectorized.
+        template<unsigned Bits, unsigned Mantissa>
+        struct log_packing {
+            using storage = packed_code<Bits>;
+
+            static constexpr std::uint64_t implicit_bit{std::uint64_t{1} << Mantissa};
+            static constexpr std::uint64_t max_code{log_max_code(Mantissa)};
+
+            static constexpr storage encode(const std::uint64_t value)
+            {
+                const auto shift{std::max(bit_width(value), Mantissa + 1) - (Mantissa + 1)};
+                const auto rounding{((value << 1) >> shift) & 1};
+                const auto code{(std::uint64_t{shift} << Mantissa) + (value >> shift) + rounding};
+                return code_access<storage>::store(code < max_code ? code : max_code);
+            }
+
+            static constexpr std::uint64_t decode(const storage &stored)
+            {
+                const auto code{code_access<storage>::load(stored)};
+                const auto exponent{static_cast<unsigned>(code >> Mantissa)};
+                const auto significand{(code & (implicit_bit - 1)) |
+                                       (std::uint64_t{std::min(exponent, 1u)} << Mantissa)};
+                return significand << (std::max(exponent, 1u) - 1);
+            }
+        };
+
+        // Exact size, stored as is.
+        template<unsigned Bits>
+        struct exact_packing {
+            using storage = packed_bytes<Bits>;
+
+            static constexpr std::uint64_t max_value{(std::uint64_t{1} << Bits) - 1};
+
+            static constexpr storage encode(const std::uint64_t value)
+            {
+                const std::uint64_t clamped{value < max_value ? value : max_value};
+                return code_access<storage>::store(clamped);
+            }
+
+            static constexpr std::uint64_t decode(const storage &code) { return code_access<storage>::load(code); }
+        };
+
+        template<unsigned Bits>
+        using finest_relative_error = std::ratio<1, (std::intmax_t{1} << (finest_mantissa(Bits) + 1))>;
+
+        template<unsigned Bits, typename RelativeError>
+        using packing = typename std::conditional<(Bits <= 32), log_packing<Bits, mantissa_for<RelativeError>()>,
+                                                  exact_packing<Bits>>::type;
+    } // namespace details
+
+    // Compact storage for a memory size. Up to 32 bits, the size is kept on a logarithmic scale with a relative
+    // error of at most RelativeError, by default the finest the width allows over the whole 64-bit range: about
+    // 0.05% for 16 bits and 1e-8 for 32 bits. Wider formats, e.g. 40 or 48 bits, hold the exact size up to
+    // 2^Bits - 1 bytes. Sizes beyond the largest representable value saturate. Every format takes exactly Bits / 8
+    // bytes: widths other than 8, 16 and 32 bits are stored on byte arrays.
+    template<unsigned Bits, typename RelativeError = details::finest_relative_error<(Bits <= 32 ? Bits : 32)>>
+    class packed_size {
+        static_assert(Bits >= 8 && Bits < 64 && Bits % 8 == 0, "The width must be a whole number of bytes below 64");
+        static_assert(details::is_ratio<RelativeError>::value, "The relative error must be a std::ratio");
+        static_assert(Bits > 32 || details::log_format_fits(Bits, details::mantissa_for<RelativeError>()),
+                      "The relative error is too fine for the width");
+
+        using codec = details::packing<Bits, RelativeError>;
+
+    public:
+        using storage = typename codec::storage;
+
+        constexpr packed_size() = default;
+
+        template<typename Rep, typename Factor>
+        constexpr explicit packed_size(const memory_size<Rep, Factor> &size) :
+            code(codec::encode(memory_size_cast<bytes>(size).count()))
+        {
+        }
+
+        [[nodiscard]] constexpr bytes size() const { return bytes(codec::decode(code)); }
+
+        template<typename To>
+        [[nodiscard]] constexpr details::Precondition<details::is_memory_size<To>::value, To> as() const
+        {
+            return memory_size_cast<To>(size());
+        }
+
+        [[nodiscard]] constexpr storage raw() const { return code; }
+
+        [[nodiscard]] static constexpr bytes max() { return bytes(codec::decode(codec::encode(~std::uint64_t{0}))); }
+
+        template<typename InputIt, typename OutputIt>
+        static OutputIt encode(InputIt first, const InputIt last, OutputIt out)
+        {
+            return std::transform(first, last, out, [](const auto &size) { return packed_size(size); });
+        }
+
+        template<typename InputIt, typename OutputIt>
+        static OutputIt decode(InputIt first, const InputIt last, OutputIt out)
+        {
+            return std::transform(first, last, out, [](const packed_size &packed) { return packed.size(); });
+        }
+
+        friend constexpr bool operator==(const packed_size &lhs, const packed_size &rhs)
+        {
+            return lhs.size() == rhs.size();
+        }
+
+        friend constexpr bool operator!=(const packed_size &lhs, const packed_size &rhs) { return !(lhs == rhs); }
+
+        friend constexpr bool operator<(const packed_size &lhs, const packed_size &rhs)
+        {
+            return lhs.size() < rhs.size();
+        }
+
+        friend constexpr bool operator>(const packed_size &lhs, const packed_size &rhs) { return rhs < lhs; }
+
+        friend constexpr bool operator<=(const packed_size &lhs, const packed_size &rhs) { return !(rhs < lhs); }
+
+        friend constexpr bool operator>=(const packed_size &lhs, const packed_size &rhs) { return !(lhs < rhs); }
+
+    private:
+        storage code{};
+    };
+} // namespace mu
+
+#endif // MEMORY_UNITS_PACKED_HPP
@@ -0,0 +1,197 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#ifndef MEMORY_UNITS_POSIX_HPP
+#define MEMORY_UNITS_POSIX_HPP
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "memory_units.hpp"
+
+namespace mu
+{
+    // Page size of the system, the runtime counterpart of mu::pages.
+    inline bytes page_size()
+    {
+        static const bytes size(static_cast<std::uint64_t>(::sysconf(_SC_PAGESIZE)));
+        return size;
+    }
+
+    namespace details
+    {
+        class file_descriptor {
+        public:
+            file_descriptor() = default;
+
+            explicit file_descriptor(const int fd) : fd(fd) {}
+
+            file_descriptor(const file_descriptor &) = delete;
+
+            file_descriptor &operator=(const file_descriptor &) = delete;
+
+            file_descriptor(file_descriptor &&other) noexcept : fd(other.release()) {}
+
+            file_descriptor &operator=(file_descriptor &&other) noexcept
+            {
+                if (this != &other)
+                    reset(other.release());
+                return *this;
+            }
+
+            [[nodiscard]] int get() const { return fd; }
+
+            [[nodiscard]] bool valid() const { return fd >= 0; }
+
+            int release() noexcept
+            {
+                const auto released{fd};
+                fd = -1;
+                return released;
+            }
+
+            void reset(const int other = -1) noexcept
+            {
+                if (fd >= 0)
+                    ::close(fd);
+                fd = other;
+            }
+
+            ~file_descriptor() { reset(); }
+
+        private:
+            int fd{-1};
+        };
+
+        class memory_mapping {
+        public:
+            memory_mapping() = default;
+
+            memory_mapping(void *const address, const std::size_t size) : address(address), length(size) {}
+
+            memory_mapping(const memory_mapping &) = delete;
+
+            memory_mapping &operator=(const memory_mapping &) = delete;
+
+            memory_mapping(memory_mapping &&other) noexcept : address(other.address), length(other.length)
+            {
+                other.address = nullptr;
+                other.length = 0;
+            }
+
+            memory_mapping &operator=(memory_mapping &&other) noexcept
+            {
+                if (this != &other) {
+                    reset();
+                    std::swap(address, other.address);
+                    std::swap(length, other.length);
+                }
+                return *this;
+            }
+
+            [[nodiscard]] void *get() const { return address; }
+
+            [[nodiscard]] std::size_t size() const { return length; }
+
+            [[nodiscard]] bool valid() const { return address != nullptr; }
+
+            void reset() noexcept
+            {
+                if (address != nullptr)
+                    ::munmap(address, length);
+                address = nullptr;
+                length = 0;
+            }
+
+            ~memory_mapping() { reset(); }
+
+        private:
+            void *address{nullptr};
+            std::size_t length{0};
+        };
+
+        inline file_descriptor open_read_only(const std::string &path)
+        {
+            return file_descriptor(::open(path.c_str(), O_RDONLY | O_CLOEXEC));
+        }
+
+        // Reads up to size bytes at an offset, stopping early only at the end of the file.
+        inline std::size_t read_from(const file_descriptor &file, char *buffer, const std::size_t size,
+                                     const std::uint64_t offset)
+        {
+            std::size_t length{0};
+            while (length < size) {
+                const auto result{::pread(file.get(), buffer + length, size - length,
+                                          static_cast<off_t>(offset + length))};
+                if (result < 0) {
+                    if (errno == EINTR)
+                        continue;
+                    throw std::system_error(errno, std::generic_category(), "Unable to read file");
+                }
+                if (result == 0)
+                    break;
+                length += static_cast<std::size_t>(result);
+            }
+            return length;
+        }
+
+        // Reads a file from its beginning. procfs regenerates the content on every read at offset zero, so the same
+        // descriptor can be sampled again and again without reopening the file.
+        inline std::size_t read_from_start(const file_descriptor &file, char *buffer, const std::size_t size)
+        {
+            return read_from(file, buffer, size, 0);
+        }
+
+        inline void write_all(const file_descriptor &file, const char *data, std::size_t size)
+        {
+            while (size > 0) {
+                const auto result{::write(file.get(), data, size)};
+                if (result < 0) {
+                    if (errno == EINTR)
+                        continue;
+                    throw std::system_error(errno, std::generic_category(), "Unable to write file");
+                }
+                data += result;
+                size -= static_cast<std::size_t>(result);
+            }
+        }
+
+        // Creates an anonymous file in a directory: the name is unlinked right away, so the storage is released as
+        // soon as the descriptor is closed, even if the process dies.
+        inline file_descriptor create_temporary_file(const std::string &directory)
+        {
+            auto path{directory + "/mu-XXXXXX"};
+            file_descriptor file(::mkostemp(&path[0], O_CLOEXEC));
+            if (!file.valid())
+                throw std::system_error(errno, std::generic_category(), "Unable to create a temporary file in " +
+                                                                                directory);
+            ::unlink(path.c_str());
+            return file;
+        }
+    } // namespace details
+} // namespace mu
+
+#endif // MEMORY_UNITS_POSIX_HPP
@@ -0,0 +1,173 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#ifndef MEMORY_UNITS_PROCESS_MEMORY_HPP
+#define MEMORY_UNITS_PROCESS_MEMORY_HPP
+#if !defined(__linux__)
+#error "Process memory introspection relies on procfs and is only available on Linux"
+#endif
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <system_error>
+#include <malloc.h>
+#include "memory_units_posix.hpp"
+
+namespace mu
+{
+    namespace details
+    {
+        inline const char *parse_unsigned(const char *it, const char *const end, std::uint64_t &value)
+        {
+            while (it != end && (*it == ' ' || *it == '\t'))
+                ++it;
+            value = 0;
+            for (; it != end && *it >= '0' && *it <= '9'; ++it)
+                value = value * 10 + static_cast<std::uint64_t>(*it - '0');
+            return it;
+        }
+
+        // Reads a whole procfs file into a buffer. The buffer is one byte larger than the content it accepts, so a
+        // file that fills it is longer than expected and is reported instead of being silently truncated.
+        template<std::size_t Size>
+        std::size_t read_procfs(const file_descriptor &file, char (&buffer)[Size])
+        {
+            const auto length{read_from_start(file, buffer, Size)};
+            if (length == Size)
+                throw std::system_error(EFBIG, std::generic_category(), "The procfs file does not fit in the buffer");
+            return length;
+        }
+
+        struct proc_field {
+            const char *key;
+            bytes *destination;
+        };
+
+        // Parses the "Key:   1234 kB" lines of procfs files such as status or smaps_rollup in a single pass over
+        // the buffer, without allocating.
+        template<std::size_t Count>
+        void parse_kb_fields(const char *it, const char *const end, const proc_field (&fields)[Count])
+        {
+            while (it != end) {
+                const auto remaining{static_cast<std::size_t>(end - it)};
+                const auto line_end{static_cast<const char *>(std::memchr(it, '\n', remaining))};
+                const auto next{line_end ? line_end : end};
+                for (const auto &field : fields) {
+                    const auto length{std::strlen(field.key)};
+                    if (static_cast<std::size_t>(next - it) > length && std::memcmp(it, field.key, length) == 0 &&
+                        it[length] == ':') {
+                        std::uint64_t kilobytes{0};
+                        parse_unsigned(it + length + 1, next, kilobytes);
+                        *field.destination = memory_size_cast<bytes>(kibibytes(kilobytes));
+                        break;
+                    }
+                }
+                it = line_end ? line_end + 1 : end;
+            }
+        }
+    } // namespace details
+
+    namespace process_memory
+    {
+        struct usage {
+            bytes resident;
+            bytes peak_resident;
+            bytes anonymous;
+            bytes file_backed;
+            bytes shared_memory;
+            bytes swap;
+            bytes heap_arena;
+            bytes heap_in_use;
+        };
+
+        // Keeps the procfs files of a process open so that every sample costs a pread and an in-place parse of a
+        // stack buffer, cheap enough to be called at kHz rates from a sampling thread.
+        class sampler {
+        public:
+            explicit sampler(const std::string &proc_directory = "/proc/self") :
+                status(details::open_read_only(proc_directory + "/status")),
+                statm(details::open_read_only(proc_directory + "/statm")),
+                smaps_rollup(details::open_read_only(proc_directory + "/smaps_rollup"))
+            {
+                if (!status.valid() || !statm.valid())
+                    throw std::system_error(errno, std::generic_category(), "Unable to open " + proc_directory);
+            }
+
+            [[nodiscard]] usage snapshot() const
+            {
+                char buffer[buffer_size];
+                const auto length{details::read_procfs(status, buffer)};
+                usage sample{};
+                const details::proc_field fields[]{
+                        {"VmRSS", &sample.resident},    {"VmHWM", &sample.peak_resident},
+                        {"RssAnon", &sample.anonymous}, {"RssFile", &sample.file_backed},
+                        {"RssShmem", &sample.shared_memory}, {"VmSwap", &sample.swap}};
+                details::parse_kb_fields(buffer, buffer + length, fields);
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+                const auto heap{::mallinfo2()};
+                sample.heap_arena = bytes(heap.arena + heap.hblkhd);
+                sample.heap_in_use = bytes(heap.uordblks + heap.hblkhd);
+#endif
+                return sample;
+            }
+
+            // Resident set size from statm, the cheapest figure the kernel exposes.
+            [[nodiscard]] bytes resident() const
+            {
+                char buffer[128];
+                const auto length{details::read_procfs(statm, buffer)};
+                std::uint64_t size_pages{0};
+                std::uint64_t resident_pages{0};
+                const auto it{details::parse_unsigned(buffer, buffer + length, size_pages)};
+                details::parse_unsigned(it, buffer + length, resident_pages);
+                return bytes(resident_pages * page_size().count());
+            }
+
+            // Proportional set size from smaps_rollup. The kernel walks every mapping to produce it, so it is much
+            // more expensive than the other figures.
+            [[nodiscard]] bytes proportional_resident() const
+            {
+                if (!smaps_rollup.valid())
+                    throw std::system_error(ENOENT, std::generic_category(), "smaps_rollup is not available");
+                char buffer[buffer_size];
+                const auto length{details::read_procfs(smaps_rollup, buffer)};
+                bytes proportional{};
+                const details::proc_field fields[]{{"Pss", &proportional}};
+                details::parse_kb_fields(buffer, buffer + length, fields);
+                return proportional;
+            }
+
+        private:
+            static constexpr std::size_t buffer_size{4096};
+
+            details::file_descriptor status;
+            details::file_descriptor statm;
+            details::file_descriptor smaps_rollup;
+        };
+
+        inline usage snapshot()
+        {
+            static thread_local const sampler self;
+            return self.snapshot();
+        }
+    } // namespace process_memory
+} // namespace mu
+
+#endif // MEMORY_UNITS_PROCESS_MEMORY_HPP
@@ -0,0 +1,282 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef MEMORY_UNITS_QUANTILE_SKETCH_HPP
+#define MEMORY_UNITS_QUANTILE_SKETCH_HPP
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "memory_units.hpp"
+
+namespace mu
+{
+    namespace details
+    {
+        struct centroid {
+            double mean;
+            double weight;
+        };
+
+        // LSD radix sort on bytes. All the histograms are gathered in a single pass and the passes whose byte is
+        // the same for every key are skipped, which is the common case for the high bytes of memory sizes.
+        inline void radix_sort(std::uint64_t *const data, std::uint64_t *const aux, const std::size_t size)
+        {
+            if (size < 2)
+                return;
+            std::size_t histograms[8][256] = {};
+            for (std::size_t i{0}; i < size; ++i)
+                for (unsigned pass{0}; pass < 8; ++pass)
+                    ++histograms[pass][(data[i] >> (8 * pass)) & 0xFF];
+            auto source{data};
+            auto target{aux};
+            for (unsigned pass{0}; pass < 8; ++pass) {
+                auto &histogram{histograms[pass]};
+                if (histogram[(source[0] >> (8 * pass)) & 0xFF] == size)
+                    continue;
+                std::size_t offset{0};
+                for (auto &bucket : histogram) {
+                    const auto count{bucket};
+                    bucket = offset;
+                    offset += count;
+                }
+                for (std::size_t i{0}; i < size; ++i)
+                    target[histogram[(source[i] >> (8 * pass)) & 0xFF]++] = source[i];
+                std::swap(source, target);
+            }
+            if (source != data)
+                std::copy(source, source + size, data);
+        }
+    } // namespace details
+
+    // Mergeable streaming quantile estimator (merging t-digest) over memory sizes. Every buffer is allocated once
+    // at construction from the memory budget, so the footprint never grows with the number of inserted values.
+    class size_quantile_sketch {
+    public:
+        template<typename Rep, typename Factor>
+        explicit size_quantile_sketch(const memory_size<Rep, Factor> &budget)
+        {
+            // Per centroid slot: the centroid, its double-buffered copy, four raw buffered values and their radix
+            // sort scratch space.
+            constexpr std::uint64_t slot_size{2 * sizeof(details::centroid) + 8 * sizeof(std::uint64_t)};
+            const auto slots{memory_size_cast<bytes>(budget).count() / slot_size};
+            if (slots < min_centroids)
+                throw std::invalid_argument("The memory budget of the quantile sketch is too small");
+            compression = static_cast<double>(slots - 4);
+            centroids.reserve(static_cast<std::size_t>(slots));
+            merged.reserve(static_cast<std::size_t>(slots));
+            buffer.reserve(static_cast<std::size_t>(4 * slots));
+            sort_space.resize(static_cast<std::size_t>(4 * slots));
+        }
+
+        template<typename Rep, typename Factor>
+        void insert(const memory_size<Rep, Factor> &size)
+        {
+            insert_value(memory_size_cast<bytes>(size).count());
+        }
+
+        template<typename InputIt>
+        void insert(InputIt first, InputIt last)
+        {
+            for (; first != last; ++first)
+                insert(*first);
+        }
+
+        void merge(const size_quantile_sketch &other)
+        {
+            if (&other == this) {
+                const auto copy{other};
+                merge(copy);
+                return;
+            }
+            for (const auto value : other.buffer)
+                insert_value(value);
+            if (other.centroids.empty())
+                return;
+            flush();
+            for (const auto &centroid : other.centroids)
+                total_weight += centroid.weight;
+            fold(other.centroids.cbegin(), other.centroids.cend(),
+                 [](const details::centroid &centroid) { return centroid; });
+            smallest = std::min(smallest, other.smallest);
+            largest = std::max(largest, other.largest);
+        }
+
+        // Folds the buffered values into the digest first, so that even a query modifies the sketch.
+        [[nodiscard]] bytes quantile(double q)
+        {
+            flush();
+            if (centroids.empty())
+                return bytes::zero();
+            q = std::min(std::max(q, 0.0), 1.0);
+            const auto target{q * total_weight};
+            const auto &first{centroids.front()};
+            const auto &last{centroids.back()};
+            if (target < first.weight / 2)
+                return to_bytes(interpolate(static_cast<double>(smallest), first.mean, target / (first.weight / 2)));
+            if (target > total_weight - last.weight / 2) {
+                const auto tail{(target - (total_weight - last.weight / 2)) / (last.weight / 2)};
+                return to_bytes(interpolate(last.mean, static_cast<double>(largest), tail));
+            }
+            auto cumulative{first.weight / 2};
+            for (std::size_t i{1}; i < centroids.size(); ++i) {
+                const auto &left{centroids[i - 1]};
+                const auto &right{centroids[i]};
+                const auto gap{(left.weight + right.weight) / 2};
+                if (target <= cumulative + gap)
+                    return to_bytes(interpolate(left.mean, right.mean, (target - cumulative) / gap));
+                cumulative += gap;
+            }
+            return to_bytes(last.mean);
+        }
+
+        [[nodiscard]] bytes p50() { return quantile(0.5); }
+
+        [[nodiscard]] bytes p99() { return quantile(0.99); }
+
+        [[nodiscard]] bytes p999() { return quantile(0.999); }
+
+        [[nodiscard]] bytes min() const { return empty() ? bytes::zero() : bytes(smallest); }
+
+        [[nodiscard]] bytes max() const { return empty() ? bytes::zero() : bytes(largest); }
+
+        [[nodiscard]] std::uint64_t count() const
+        {
+            return static_cast<std::uint64_t>(total_weight) + static_cast<std::uint64_t>(buffer.size());
+        }
+
+        [[nodiscard]] bool empty() const { return count() == 0; }
+
+        [[nodiscard]] bytes footprint() const
+        {
+            return bytes((centroids.capacity() + merged.capacity()) * sizeof(details::centroid) +
+                         (buffer.capacity() + sort_space.capacity()) * sizeof(std::uint64_t));
+        }
+
+        void clear()
+        {
+            centroids.clear();
+            buffer.clear();
+            total_weight = 0;
+            smallest = std::numeric_limits<std::uint64_t>::max();
+            largest = 0;
+        }
+
+    private:
+        static constexpr std::size_t min_centroids{16};
+
+        void insert_value(const std::uint64_t value)
+        {
+            if (buffer.size() == buffer.capacity())
+                flush();
+            buffer.push_back(value);
+            smallest = std::min(smallest, value);
+            largest = std::max(largest, value);
+        }
+
+        // Sorts the pending raw values as plain integers with a branch-free radix sort, which is much cheaper than
+        // a comparison sort of random sizes, and folds them into the digest in a single merge pass.
+        void flush()
+        {
+            if (buffer.empty())
+                return;
+            details::radix_sort(buffer.data(), sort_space.data(), buffer.size());
+            total_weight += static_cast<double>(buffer.size());
+            fold(buffer.cbegin(), buffer.cend(),
+                 [](const std::uint64_t value) { return details::centroid{static_cast<double>(value), 1.0}; });
+            buffer.clear();
+        }
+
+        // Merges the current centroids with a sorted incoming sequence, greedily collapsing neighbours as long as
+        // the merged centroid spans at most one unit of the k1 scale function
+        // k(q) = compression / (2 * pi) * asin(2 * q - 1), which keeps the centroids small near both tails. The
+        // output size only depends on the compression, never on the length of the incoming sequence.
+        template<typename ForwardIt, typename ToCentroid>
+        void fold(ForwardIt first, const ForwardIt last, const ToCentroid to_centroid)
+        {
+            const auto normalizer{compression / (2 * pi)};
+            auto existing{centroids.cbegin()};
+            const auto next = [&]() {
+                if (first == last || (existing != centroids.cend() && existing->mean < to_centroid(*first).mean))
+                    return *existing++;
+                return to_centroid(*first++);
+            };
+            merged.clear();
+            auto current{next()};
+            auto weight_so_far{0.0};
+            auto weight_limit{q_limit_of(0.0, normalizer) * total_weight};
+            while (first != last || existing != centroids.cend()) {
+                const auto candidate{next()};
+                if (weight_so_far + current.weight + candidate.weight <= weight_limit) {
+                    current.weight += candidate.weight;
+                    current.mean += (candidate.mean - current.mean) * candidate.weight / current.weight;
+                }
+                else {
+                    weight_so_far += current.weight;
+                    merged.push_back(current);
+                    weight_limit = q_limit_of(weight_so_far / total_weight, normalizer) * total_weight;
+                    current = candidate;
+                }
+            }
+            merged.push_back(current);
+            centroids.swap(merged);
+        }
+
+        static double q_limit_of(const double q, const double normalizer)
+        {
+            const auto k{normalizer * std::asin(2 * q - 1) + 1};
+            if (k >= normalizer * pi / 2)
+                return 1.0;
+            return (std::sin(k / normalizer) + 1) / 2;
+        }
+
+        static double interpolate(const double from, const double to, const double ratio)
+        {
+            return from + (to - from) * ratio;
+        }
+
+        [[nodiscard]] bytes to_bytes(const double value) const
+        {
+            // The largest sizes do not fit in a long long, and rounding them up may even overflow 64 bits.
+            const auto rounded{std::round(value)};
+            if (rounded <= static_cast<double>(smallest))
+                return bytes(smallest);
+            if (rounded >= static_cast<double>(largest))
+                return bytes(largest);
+            return bytes(static_cast<std::uint64_t>(rounded));
+        }
+
+        static constexpr double pi{3.14159265358979323846};
+
+        double compression{0};
+        std::uint64_t smallest{std::numeric_limits<std::uint64_t>::max()};
+        std::uint64_t largest{0};
+        double total_weight{0};
+        std::vector<details::centroid> centroids;
+        std::vector<std::uint64_t> buffer;
+        std::vector<std::uint64_t> sort_space;
+        std::vector<details::centroid> merged;
+    };
+} // namespace mu
+
+#endif // MEMORY_UNITS_QUANTILE_SKETCH_HPP
@@ -0,0 +1,344 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#ifndef MEMORY_UNITS_QUEUE_HPP
+#define MEMORY_UNITS_QUEUE_HPP
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "memory_units.hpp"
+
+namespace mu
+{
+    namespace details
+    {
+        struct shallow_size {
+            template<typename Tp>
+            constexpr bytes operator()(const Tp &) const
+            {
+                return bytes(sizeof(Tp));
+            }
+        };
+    } // namespace details
+
+    // Multi-producer multi-consumer queue bounded by the total size of its elements. The fast path is lock-free: a
+    // compare-and-swap reserves the bytes of an element, then a slot of a bounded ring whose slots carry sequence
+    // numbers (D. Vyukov's design). Batch operations claim many slots and bytes with a single atomic each. The
+    // blocking variants only touch a mutex once the queue is full or empty.
+    template<typename T, typename SizeFn = details::shallow_size>
+    class byte_bounded_queue {
+    public:
+        template<typename Rep, typename Factor>
+        explicit byte_bounded_queue(const memory_size<Rep, Factor> &capacity, const std::size_t max_elements = 1 << 16,
+                                    SizeFn size_of = SizeFn()) :
+            budget(memory_size_cast<bytes>(capacity).count()), size_of(std::move(size_of)),
+            mask(round_up_power_of_two(max_elements) - 1), slots(new slot[mask + 1])
+        {
+            for (std::size_t i{0}; i <= mask; ++i)
+                slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        byte_bounded_queue(const byte_bounded_queue &) = delete;
+
+        byte_bounded_queue &operator=(const byte_bounded_queue &) = delete;
+
+        template<typename Up>
+        bool try_push(Up &&value)
+        {
+            if (!push_one(std::forward<Up>(value)))
+                return false;
+            wake(pop_waiters);
+            return true;
+        }
+
+        // Blocks while the byte budget or the ring is full. The retries happen under the mutex, so that a consumer
+        // making room cannot notify between a failed retry and the wait.
+        template<typename Up>
+        void push(Up &&value)
+        {
+            if (try_push(std::forward<Up>(value)))
+                return;
+            std::unique_lock<std::mutex> lock(mutex);
+            ++push_waiters;
+            while (!push_one(std::forward<Up>(value)))
+                not_full.wait(lock);
+            --push_waiters;
+            lock.unlock();
+            wake(pop_waiters);
+        }
+
+        bool try_pop(T &value)
+        {
+            if (!pop_one(value))
+                return false;
+            wake(push_waiters);
+            return true;
+        }
+
+        T pop()
+        {
+            T value;
+            if (try_pop(value))
+                return value;
+            std::unique_lock<std::mutex> lock(mutex);
+            ++pop_waiters;
+            while (!pop_one(value))
+                not_empty.wait(lock);
+            --pop_waiters;
+            lock.unlock();
+            wake(push_waiters);
+            return value;
+        }
+
+        // Moves as many elements of [first, last) as the byte budget and the ring allow, and returns the iterator
+        // past the last element pushed.
+        template<typename ForwardIt>
+        ForwardIt try_push_batch(ForwardIt first, const ForwardIt last)
+        {
+            while (first != last) {
+                std::uint64_t charges[batch_size];
+                std::size_t count{0};
+                std::uint64_t total{0};
+                for (auto it{first}; it != last && count < batch_size; ++it, ++count)
+                    total += (charges[count] = memory_size_cast<bytes>(size_of(*it)).count());
+                const auto reserved{reserve_prefix(charges, count, total)};
+                if (reserved == 0)
+                    break;
+                std::size_t position;
+                const auto claimed{claim(enqueue_position.value, 0, reserved, position)};
+                std::uint64_t unused{0};
+                for (auto i{claimed}; i < reserved; ++i)
+                    unused += charges[i];
+                release(unused);
+                for (std::size_t i{0}; i < claimed; ++i, ++first)
+                    publish(position + i, std::move(*first), charges[i]);
+                if (claimed)
+                    wake(pop_waiters);
+                if (claimed < count)
+                    break;
+            }
+            return first;
+        }
+
+        // Pops up to max_count elements into out and returns how many were popped.
+        template<typename OutputIt>
+        std::size_t try_pop_batch(OutputIt out, const std::size_t max_count)
+        {
+            std::size_t popped{0};
+            while (popped < max_count) {
+                std::size_t position;
+                const auto wanted{std::min(std::size_t{batch_size}, max_count - popped)};
+                const auto claimed{claim(dequeue_position.value, 1, wanted, position)};
+                if (claimed == 0)
+                    break;
+                std::uint64_t freed{0};
+                for (std::size_t i{0}; i < claimed; ++i) {
+                    T value;
+                    freed += consume(position + i, value);
+                    *out++ = std::move(value);
+                }
+                release(freed);
+                wake(push_waiters);
+                popped += claimed;
+            }
+            return popped;
+        }
+
+        [[nodiscard]] bytes usage() const { return bytes(used.value.load(std::memory_order_relaxed)); }
+
+        [[nodiscard]] bytes capacity() const { return bytes(budget); }
+
+        [[nodiscard]] std::size_t max_elements() const { return mask + 1; }
+
+        [[nodiscard]] bool empty() const
+        {
+            return enqueue_position.value.load(std::memory_order_relaxed) ==
+                   dequeue_position.value.load(std::memory_order_relaxed);
+        }
+
+        ~byte_bounded_queue()
+        {
+            T value;
+            while (try_pop(value)) {
+            }
+        }
+
+    private:
+        static constexpr std::size_t batch_size{64};
+        static constexpr std::size_t cache_line{64};
+
+        // Keeps the counters written by producers, by consumers and by both on separate cache lines.
+        template<typename Tp>
+        struct padded {
+            std::atomic<Tp> value{0};
+            char padding[cache_line - sizeof(std::atomic<Tp>)];
+        };
+
+        struct slot {
+            std::atomic<std::size_t> sequence;
+            std::uint64_t charge;
+            typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+        };
+
+        static std::size_t round_up_power_of_two(const std::size_t value)
+        {
+            std::size_t power{2};
+            while (power < value)
+                power <<= 1;
+            return power;
+        }
+
+        // Bytes are reserved before a slot is claimed. An element larger than the whole budget is only admitted
+        // into an empty queue, so that it cannot wait forever.
+        // The value is only moved from once the bytes and the slot are secured, so a failed attempt leaves it intact.
+        template<typename Up>
+        bool push_one(Up &&value)
+        {
+            const auto charge{memory_size_cast<bytes>(size_of(value)).count()};
+            if (!reserve(charge))
+                return false;
+            std::size_t position;
+            if (claim(enqueue_position.value, 0, 1, position) == 0) {
+                release(charge);
+                return false;
+            }
+            publish(position, std::forward<Up>(value), charge);
+            return true;
+        }
+
+        bool pop_one(T &value)
+        {
+            std::size_t position;
+            if (claim(dequeue_position.value, 1, 1, position) == 0)
+                return false;
+            release(consume(position, value));
+            return true;
+        }
+
+        bool reserve(const std::uint64_t charge)
+        {
+            auto current{used.value.load()};
+            do {
+                if (current + charge > budget && current != 0)
+                    return false;
+            } while (!used.value.compare_exchange_weak(current, current + charge));
+            return true;
+        }
+
+        std::size_t reserve_prefix(const std::uint64_t *charges, const std::size_t count, const std::uint64_t total)
+        {
+            auto current{used.value.load()};
+            while (true) {
+                std::size_t fitting{count};
+                auto sum{total};
+                while (fitting > 0 && current + sum > budget && !(current == 0 && fitting == 1))
+                    sum -= charges[--fitting];
+                if (fitting == 0)
+                    return 0;
+                if (used.value.compare_exchange_weak(current, current + sum))
+                    return fitting;
+            }
+        }
+
+        void release(const std::uint64_t charge)
+        {
+            if (charge)
+                used.value.fetch_sub(charge);
+        }
+
+        // Claims up to wanted consecutive positions whose slots are ready, that is free for producers (lag 0) or
+        // published for consumers (lag 1), and returns how many were claimed.
+        std::size_t claim(std::atomic<std::size_t> &cursor, const std::size_t lag, const std::size_t wanted,
+                          std::size_t &position)
+        {
+            position = cursor.load(std::memory_order_relaxed);
+            while (true) {
+                std::size_t ready{0};
+                while (ready < wanted && slots[(position + ready) & mask].sequence.load(std::memory_order_acquire) ==
+                                                 position + ready + lag)
+                    ++ready;
+                if (ready == 0) {
+                    const auto sequence{slots[position & mask].sequence.load(std::memory_order_acquire)};
+                    if (static_cast<std::ptrdiff_t>(sequence - (position + lag)) < 0)
+                        return 0; // Full for producers, empty for consumers
+                    position = cursor.load(std::memory_order_relaxed);
+                    continue;
+                }
+                if (cursor.compare_exchange_weak(position, position + ready, std::memory_order_relaxed))
+                    return ready;
+            }
+        }
+
+        template<typename Up>
+        void publish(const std::size_t position, Up &&value, const std::uint64_t charge)
+        {
+            auto &target{slots[position & mask]};
+            ::new (&target.storage) T(std::forward<Up>(value));
+            target.charge = charge;
+            target.sequence.store(position + 1, std::memory_order_release);
+        }
+
+        std::uint64_t consume(const std::size_t position, T &value)
+        {
+            auto &source{slots[position & mask]};
+            auto &element{*reinterpret_cast<T *>(&source.storage)};
+            value = std::move(element);
+            element.~T();
+            const auto charge{source.charge};
+            source.sequence.store(position + mask + 1, std::memory_order_release);
+            return charge;
+        }
+
+        // The fence orders the release of the slot or bytes before the load of the waiter count, pairing with the
+        // increment of the count that precedes the retries of a blocked thread.
+        void wake(const std::atomic<std::size_t> &waiters)
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (waiters.load(std::memory_order_relaxed) == 0)
+                return;
+            std::lock_guard<std::mutex> lock(mutex);
+            not_full.notify_all();
+            not_empty.notify_all();
+        }
+
+        const std::uint64_t budget;
+        SizeFn size_of;
+        const std::size_t mask;
+        std::unique_ptr<slot[]> slots;
+        char front_padding[cache_line];
+        padded<std::size_t> enqueue_position;
+        padded<std::size_t> dequeue_position;
+        padded<std::uint64_t> used;
+        std::atomic<std::size_t> push_waiters{0};
+        std::atomic<std::size_t> pop_waiters{0};
+        std::mutex mutex;
+        std::condition_variable not_full;
+        std::condition_variable not_empty;
+    };
+} // namespace mu
+
+#endif // MEMORY_UNITS_QUEUE_HPP
@@ -0,0 +1,348 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#ifndef MEMORY_UNITS_RATE_HPP
+#define MEMORY_UNITS_RATE_HPP
+#include <chrono>
+#include <limits>
+#include <ratio>
+#include <type_traits>
+#include "memory_units.hpp"
+
+namespace mu
+{
+    template<typename Rep, typename SizeFactor = std::ratio<1>, typename Period = std::ratio<1>>
+    struct memory_rate;
+
+    namespace details
+    {
+        template<typename>
+        struct is_memory_rate : std::false_type {};
+
+        template<typename Rep, typename SizeFactor, typename Period>
+        struct is_memory_rate<memory_rate<Rep, SizeFactor, Period>> : std::true_type {};
+
+        template<typename>
+        struct is_duration : std::false_type {};
+
+        template<typename Rep, typename Period>
+        struct is_duration<std::chrono::duration<Rep, Period>> : std::true_type {};
+
+        // A rate is a memory size per period: scaled by SizeFactor / Period, its count is a number of bytes per
+        // second, so every conversion reduces to a memory_size_cast between the scaled sizes.
+        template<typename Rep, typename SizeFactor, typename Period>
+        using rate_as_size = memory_size<Rep, std::ratio_divide<SizeFactor, Period>>;
+
+        template<typename Rep, typename SizeFactor, typename Period>
+        constexpr rate_as_size<Rep, SizeFactor, Period> as_size(const memory_rate<Rep, SizeFactor, Period> &rate)
+        {
+            return rate_as_size<Rep, SizeFactor, Period>(rate.count());
+        }
+    } // namespace details
+
+    namespace details
+    {
+        template<typename To, typename CommonRep, bool = std::is_floating_point<CommonRep>::value>
+        struct rate_cast_impl {
+            template<typename Rep, typename SizeFactor, typename Period>
+            static constexpr To cast(const memory_rate<Rep, SizeFactor, Period> &from)
+            {
+                using to_size = rate_as_size<typename To::rep, typename To::size_factor, typename To::period>;
+                return To(memory_size_cast<to_size>(as_size(from)).count());
+            }
+        };
+
+        template<typename To, typename CommonRep>
+        struct rate_cast_impl<To, CommonRep, true> {
+            // Floating-point rates are scaled by a single multiplication with the folded factor, where
+            // memory_size_cast multiplies and divides to stay exact.
+            template<typename Rep, typename SizeFactor, typename Period>
+            static constexpr To cast(const memory_rate<Rep, SizeFactor, Period> &from)
+            {
+                using factor = std::ratio_divide<std::ratio_divide<SizeFactor, Period>,
+                                                 std::ratio_divide<typename To::size_factor, typename To::period>>;
+                constexpr auto scale{static_cast<CommonRep>(factor::num) / static_cast<CommonRep>(factor::den)};
+                return To(static_cast<typename To::rep>(static_cast<CommonRep>(from.count()) * scale));
+            }
+        };
+    } // namespace details
+
+    template<typename To, typename Rep, typename SizeFactor, typename Period>
+    constexpr details::Precondition<details::is_memory_rate<To>::value, To>
+    rate_cast(const memory_rate<Rep, SizeFactor, Period> &from)
+    {
+        using common_rep = details::common_type_t<typename To::rep, Rep, std::intmax_t>;
+        return details::rate_cast_impl<To, common_rep>::cast(from);
+    }
+
+    template<typename Rep, typename SizeFactor, typename Period>
+    struct memory_rate {
+
+        using rep = Rep;
+        using size_factor = SizeFactor;
+        using period = Period;
+
+        static_assert(details::not_v<details::is_memory_size<Rep>>, "The representation must not be a memory_size");
+        static_assert(details::is_ratio<SizeFactor>::value, "The size factor must be a specialization of ratio");
+        static_assert(details::is_ratio<Period>::value, "The period must be a specialization of ratio");
+        static_assert(SizeFactor::num > 0 && Period::num > 0, "The size factor and the period must be positive");
+
+        constexpr memory_rate() = default;
+
+        template<typename OtherRep, typename = details::Precondition<details::and_t<
+                                            std::is_convertible<const OtherRep &, rep>,
+                                            details::or_t<std::is_floating_point<rep>,
+                                                          details::not_t<std::is_floating_point<OtherRep>>>>::value>>
+        constexpr explicit memory_rate(const OtherRep &other) : quantity(static_cast<rep>(other))
+        {
+        }
+
+        template<typename OtherRep, typename OtherSizeFactor, typename OtherPeriod,
+                 typename = details::Precondition<details::or_t<
+                         std::is_floating_point<rep>,
+                         details::and_t<details::bool_to_type<
+                                                std::ratio_divide<std::ratio_divide<OtherSizeFactor, OtherPeriod>,
+                                                                  std::ratio_divide<size_factor, period>>::den == 1>,
+                                        details::not_t<std::is_floating_point<OtherRep>>>>::value>>
+        constexpr explicit memory_rate(const memory_rate<OtherRep, OtherSizeFactor, OtherPeriod> &other) :
+            quantity(rate_cast<memory_rate>(other).count())
+        {
+        }
+
+        [[nodiscard]] constexpr rep count() const { return quantity; }
+
+        constexpr memory_rate operator+() const { return *this; }
+
+        constexpr memory_rate operator-() const { return memory_rate(-quantity); }
+
+        constexpr memory_rate &operator+=(const memory_rate &other)
+        {
+            quantity += other.count();
+            return *this;
+        }
+
+        constexpr memory_rate &operator-=(const memory_rate &other)
+        {
+            quantity -= other.count();
+            return *this;
+        }
+
+        constexpr memory_rate &operator*=(const rep &rhs)
+        {
+            quantity *= rhs;
+            return *this;
+        }
+
+        constexpr memory_rate &operator/=(const rep &rhs)
+        {
+            quantity /= rhs;
+            return *this;
+        }
+
+        static constexpr memory_rate zero() noexcept { return memory_rate(rep(0)); }
+
+        static constexpr memory_rate min() noexcept { return memory_rate(std::numeric_limits<rep>::lowest()); }
+
+        static constexpr memory_rate max() noexcept { return memory_rate(std::numeric_limits<rep>::max()); }
+
+    private:
+        rep quantity;
+    };
+
+    namespace details
+    {
+        // Rates of different units combine in bytes per second scaled by the common factor of their scaled sizes.
+        template<typename Rate, typename OtherRate>
+        struct memory_rate_common_type {
+            using common_size = typename memory_size_common_type<
+                    rate_as_size<typename Rate::rep, typename Rate::size_factor, typename Rate::period>,
+                    rate_as_size<typename OtherRate::rep, typename OtherRate::size_factor,
+                                 typename OtherRate::period>>::type;
+            using type = memory_rate<typename common_size::rep, typename common_size::factor, std::ratio<1>>;
+        };
+
+        template<typename Rate>
+        struct memory_rate_common_type<Rate, Rate> {
+            using type = Rate;
+        };
+    } // namespace details
+
+    template<typename Rep, typename SizeFactor, typename Period, typename OtherRep, typename OtherSizeFactor,
+             typename OtherPeriod>
+    constexpr typename details::memory_rate_common_type<memory_rate<Rep, SizeFactor, Period>,
+                                                        memory_rate<OtherRep, OtherSizeFactor, OtherPeriod>>::type
+    operator+(const memory_rate<Rep, SizeFactor, Period> &lhs,
+              const memory_rate<OtherRep, OtherSizeFactor, OtherPeriod> &rhs)
+    {
+        using common_type = typename details::memory_rate_common_type<
+                memory_rate<Rep, SizeFactor, Period>, memory_rate<OtherRep, OtherSizeFactor, OtherPeriod>>::type;
+        return common_type(rate_cast<common_type>(lhs).count() + rate_cast<common_type>(rhs).count());
+    }
+
+    template<typename Rep, typename SizeFactor, typename Period, typename OtherRep, typename OtherSizeFactor,
+             typename OtherPeriod>
+    constexpr typename details::memory_rate_common_type<memory_rate<Rep, SizeFactor, Period>,
+                                                        memory_rate<OtherRep, OtherSizeFactor, OtherPeriod>>::type
+    operator-(const memory_rate<Rep, SizeFactor, Period> &lhs,
+              const memory_rate<OtherRep, OtherSizeFactor, OtherPeriod> &rhs)
+    {
+        using common_type = typename details::memory_rate_common_type<
+                memory_rate<Rep, SizeFactor, Period>, memory_rate<OtherRep, OtherSizeFactor, OtherPeriod>>::type;
+        return common_type(rate_cast<common_type>(lhs).count() - rate_cast<common_type>(rhs).count());
+    }
+
+    template<typename Rep, typename SizeFactor, typename Period, typename OtherRep>
+    constexpr details::Precondition<details::not_v<details::or_t<details::is_memory_rate<OtherRep>,
+                                                                 details::is_duration<OtherRep>>>,
+                                    memory_rate<typename details::common_rep_type<Rep, OtherRep>::type, SizeFactor,
+                                                Period>>
+    operator*(const memory_rate<Rep, SizeFactor, Period> &lhs, const OtherRep &rhs)
+    {
+        using common_type = memory_rate<typename details::common_rep_type<Rep, OtherRep>::type, SizeFactor, Period>;
+        return common_type(common_type(lhs).count() * rhs);
+    }
+
+    template<typename Rep, typename SizeFactor, typename Period, typename OtherRep>
+    constexpr details::Precondition<details::not_v<details::or_t<details::is_memory_rate<OtherRep>,
+                                                                 details::is_duration<OtherRep>>>,
+                                    memory_rate<typename details::common_rep_type<Rep, OtherRep>::type, SizeFactor,
+                                                Period>>
+    operator/(const memory_rate<Rep, SizeFactor, Period> &lhs, const OtherRep &rhs)
+    {
+        using common_type = memory_rate<typename details::common_rep_type<Rep, OtherRep>::type, SizeFactor, Period>;
+        return common_type(common_type(lhs).count() / rhs);
+    }
+
+    template<typename Rep, typename SizeFactor, typename Period, typename OtherRep, typename OtherSizeFactor,
+             typename OtherPeriod>
+    constexpr bool operator==(const memory_rate<Rep, SizeFactor, Period> &lhs,
+                              const memory_rate<OtherRep, OtherSizeFactor, OtherPeriod> &rhs)
+    {
+        return details::as_size(lhs) == details::as_size(rhs);
+    }
+
+    template<typename Rep, typename SizeFactor, typename Period, typename OtherRep, typename OtherSizeFactor,
+             typename OtherPeriod>
+    constexpr bool operator<(const memory_rate<Rep, SizeFactor, Period> &lhs,
+                             const memory_rate<OtherRep, OtherSizeFactor, OtherPeriod> &rhs)
+    {
+        return details::as_size(lhs) < details::as_size(rhs);
+    }
+
+    template<typename Rep, typename SizeFactor, typename Period, typename OtherRep, typename OtherSizeFactor,
+             typename OtherPeriod>
+    constexpr bool operator!=(const memory_rate<Rep, SizeFactor, Period> &lhs,
+                              const memory_rate<OtherRep, OtherSizeFactor, OtherPeriod> &rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    template<typename Rep, typename SizeFactor, typename Period, typename OtherRep, typename OtherSizeFactor,
+             typename OtherPeriod>
+    constexpr bool operator<=(const memory_rate<Rep, SizeFactor, Period> &lhs,
+                              const memory_rate<OtherRep, OtherSizeFactor, OtherPeriod> &rhs)
+    {
+        return !(rhs < lhs);
+    }
+
+    template<typename Rep, typename SizeFactor, typename Period, typename OtherRep, typename OtherSizeFactor,
+             typename OtherPeriod>
+    constexpr bool operator>(const memory_rate<Rep, SizeFactor, Period> &lhs,
+                             const memory_rate<OtherRep, OtherSizeFactor, OtherPeriod> &rhs)
+    {
+        return rhs < lhs;
+    }
+
+    template<typename Rep, typename SizeFactor, typename Period, typename OtherRep, typename OtherSizeFactor,
+             typename OtherPeriod>
+    constexpr bool operator>=(const memory_rate<Rep, SizeFactor, Period> &lhs,
+                              const memory_rate<OtherRep, OtherSizeFactor, OtherPeriod> &rhs)
+    {
+        return !(lhs < rhs);
+    }
+
+    // Size over duration: the rate keeps both units, e.g. mebibytes / milliseconds is a rate in MiB/ms.
+    template<typename Rep, typename SizeFactor, typename DurationRep, typename Period>
+    constexpr memory_rate<details::common_type_t<Rep, DurationRep>, SizeFactor, Period>
+    operator/(const memory_size<Rep, SizeFactor> &size, const std::chrono::duration<DurationRep, Period> &duration)
+    {
+        using common_rep = details::common_type_t<Rep, DurationRep>;
+        return memory_rate<common_rep, SizeFactor, Period>(static_cast<common_rep>(size.count()) /
+                                                           static_cast<common_rep>(duration.count()));
+    }
+
+    // Rate times duration: exact, the size factor absorbs the ratio between the two periods.
+    template<typename Rep, typename SizeFactor, typename Period, typename DurationRep, typename DurationPeriod>
+    constexpr memory_size<details::common_type_t<Rep, DurationRep>,
+                          std::ratio_multiply<SizeFactor, std::ratio_divide<DurationPeriod, Period>>>
+    operator*(const memory_rate<Rep, SizeFactor, Period> &rate,
+              const std::chrono::duration<DurationRep, DurationPeriod> &duration)
+    {
+        using common_rep = details::common_type_t<Rep, DurationRep>;
+        using size_type = memory_size<common_rep, std::ratio_multiply<SizeFactor, std::ratio_divide<DurationPeriod,
+                                                                                                  Period>>>;
+        return size_type(static_cast<common_rep>(rate.count()) * static_cast<common_rep>(duration.count()));
+    }
+
+    template<typename Rep, typename SizeFactor, typename Period, typename DurationRep, typename DurationPeriod>
+    constexpr memory_size<details::common_type_t<Rep, DurationRep>,
+                          std::ratio_multiply<SizeFactor, std::ratio_divide<DurationPeriod, Period>>>
+    operator*(const std::chrono::duration<DurationRep, DurationPeriod> &duration,
+              const memory_rate<Rep, SizeFactor, Period> &rate)
+    {
+        return rate * duration;
+    }
+
+    // Size over rate: the time needed to transfer the size, in the period of the rate. Like a division of two
+    // durations, both sizes are expressed in their common unit first.
+    template<typename Rep, typename SizeFactor, typename RateRep, typename RateSizeFactor, typename Period>
+    constexpr std::chrono::duration<details::common_type_t<Rep, RateRep>, Period>
+    operator/(const memory_size<Rep, SizeFactor> &size, const memory_rate<RateRep, RateSizeFactor, Period> &rate)
+    {
+        using common_size = typename details::memory_size_common_type<memory_size<Rep, SizeFactor>,
+                                                                      memory_size<RateRep, RateSizeFactor>>::type;
+        using common_rep = details::common_type_t<Rep, RateRep>;
+        return std::chrono::duration<common_rep, Period>(
+                static_cast<common_rep>(common_size(size).count()) /
+                static_cast<common_rep>(common_size(memory_size<RateRep, RateSizeFactor>(rate.count())).count()));
+    }
+
+    using bytes_per_second = memory_rate<INT_UNIT_TYPE>;
+    using kilobytes_per_second = memory_rate<INT_UNIT_TYPE, details::kb>;
+    using megabytes_per_second = memory_rate<INT_UNIT_TYPE, details::mb>;
+    using gigabytes_per_second = memory_rate<INT_UNIT_TYPE, details::gb>;
+    using kibibytes_per_second = memory_rate<INT_UNIT_TYPE, details::kib>;
+    using mebibytes_per_second = memory_rate<INT_UNIT_TYPE, details::mib>;
+    using gibibytes_per_second = memory_rate<INT_UNIT_TYPE, details::gib>;
+    using megabits_per_second = memory_rate<INT_UNIT_TYPE, details::mbit>;
+    using gigabits_per_second = memory_rate<INT_UNIT_TYPE, details::gbit>;
+
+    using f_bytes_per_second = memory_rate<FLOAT_UNIT_TYPE>;
+    using f_kilobytes_per_second = memory_rate<FLOAT_UNIT_TYPE, details::kb>;
+    using f_megabytes_per_second = memory_rate<FLOAT_UNIT_TYPE, details::mb>;
+    using f_gigabytes_per_second = memory_rate<FLOAT_UNIT_TYPE, details::gb>;
+    using f_kibibytes_per_second = memory_rate<FLOAT_UNIT_TYPE, details::kib>;
+    using f_mebibytes_per_second = memory_rate<FLOAT_UNIT_TYPE, details::mib>;
+    using f_gibibytes_per_second = memory_rate<FLOAT_UNIT_TYPE, details::gib>;
+    using f_megabits_per_second = memory_rate<FLOAT_UNIT_TYPE, details::mbit>;
+    using f_gigabits_per_second = memory_rate<FLOAT_UNIT_TYPE, details::gbit>;
+} // namespace mu
+
+#endif // MEMORY_UNITS_RATE_HPP
@@ -0,0 +1,236 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#ifndef MEMORY_UNITS_RATE_LIMITER_HPP
+#define MEMORY_UNITS_RATE_LIMITER_HPP
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include "memory_units_rate.hpp"
+
+namespace mu
+{
+    // Token bucket limiting a flow of bytes to a rate, with bursts up to a size, implemented as a generic cell
+    // rate algorithm: the whole state is the theoretical arrival time of the next byte, updated with a single
+    // compare-and-swap. A request fits when granting it would not push that time further ahead of now than the
+    // burst. A request larger than the burst is only granted when the bucket is full and puts it in debt.
+    //
+    // Time is counted in whole nanoseconds since the construction, which lasts for centuries. The fraction of a
+    // nanosecond a request costs beyond its whole nanoseconds is accumulated apart and charged once it adds up to
+    // a whole one, so that fast rates are still enforced exactly.
+    //
+    // Tiny requests are served from a credit cached per thread and refilled from the shared state a batch at a
+    // time, so that threads acquiring a few bytes at a time do not contend on the atomic. Each thread can run
+    // ahead of the rate by at most one batch.
+    class byte_rate_limiter {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        template<typename Rep, typename SizeFactor, typename Period, typename BurstRep, typename BurstFactor>
+        byte_rate_limiter(const memory_rate<Rep, SizeFactor, Period> &rate,
+                          const memory_size<BurstRep, BurstFactor> &burst) :
+            byte_rate_limiter(rate, burst, default_credit_batch(memory_size_cast<bytes>(burst)))
+        {
+        }
+
+        // A credit batch of zero disables the per-thread caching.
+        template<typename Rep, typename SizeFactor, typename Period, typename BurstRep, typename BurstFactor,
+                 typename BatchRep, typename BatchFactor>
+        byte_rate_limiter(const memory_rate<Rep, SizeFactor, Period> &rate,
+                          const memory_size<BurstRep, BurstFactor> &burst,
+                          const memory_size<BatchRep, BatchFactor> &credit_batch) :
+            bytes_per_second(rate_cast<f_bytes_per_second>(rate).count()),
+            nanoseconds_per_byte(1e9 / bytes_per_second),
+            burst_bytes(memory_size_cast<bytes>(burst).count()),
+            burst_nanoseconds(static_cast<std::uint64_t>(static_cast<double>(burst_bytes) * nanoseconds_per_byte)),
+            batch_bytes(std::min(memory_size_cast<bytes>(credit_batch).count(), burst_bytes)),
+            epoch(clock::now()), id(next_id().fetch_add(1, std::memory_order_relaxed))
+        {
+            if (!(bytes_per_second > 0))
+                throw std::invalid_argument("The rate of a rate limiter must be positive");
+        }
+
+        byte_rate_limiter(const byte_rate_limiter &) = delete;
+
+        byte_rate_limiter &operator=(const byte_rate_limiter &) = delete;
+
+        template<typename Rep, typename Factor>
+        bool try_acquire(const memory_size<Rep, Factor> &size)
+        {
+            const auto amount{memory_size_cast<bytes>(size).count()};
+            if (!is_tiny(amount))
+                return try_reserve(amount);
+            auto &credit{credit_slot()};
+            if (credit.remaining >= amount) {
+                credit.remaining -= amount;
+                return true;
+            }
+            if (try_reserve(batch_bytes)) {
+                credit.remaining += batch_bytes - amount;
+                return true;
+            }
+            return try_reserve(amount);
+        }
+
+        // Waits until the bytes conform to the rate. The bytes are reserved right away, so that the waiting
+        // callers are served in order and a large request cannot be starved by small ones.
+        template<typename Rep, typename Factor>
+        void acquire(const memory_size<Rep, Factor> &size)
+        {
+            const auto amount{memory_size_cast<bytes>(size).count()};
+            if (!is_tiny(amount)) {
+                wait_for(reserve(amount));
+                return;
+            }
+            auto &credit{credit_slot()};
+            if (credit.remaining < amount) {
+                wait_for(reserve(batch_bytes));
+                credit.remaining += batch_bytes;
+            }
+            credit.remaining -= amount;
+        }
+
+        [[nodiscard]] f_bytes_per_second rate() const { return f_bytes_per_second(bytes_per_second); }
+
+        [[nodiscard]] bytes burst() const { return bytes(burst_bytes); }
+
+        [[nodiscard]] bytes credit_batch() const { return bytes(batch_bytes); }
+
+        // Bytes that could be acquired right now without waiting, ignoring the credits cached by the threads.
+        [[nodiscard]] bytes available() const
+        {
+            const auto now{nanoseconds_now()};
+            const auto tat{theoretical_arrival.load(std::memory_order_relaxed)};
+            const auto ahead{tat > now ? tat - now : 0};
+            return bytes(ahead >= burst_nanoseconds
+                                 ? 0
+                                 : static_cast<std::uint64_t>((burst_nanoseconds - ahead) / nanoseconds_per_byte));
+        }
+
+    private:
+        // The cost of a request in whole nanoseconds, and the rest in 1/2^32 of nanosecond.
+        struct cost {
+            std::uint64_t whole;
+            std::uint64_t fraction;
+        };
+
+        struct credit {
+            std::uint64_t limiter;
+            std::uint64_t remaining;
+        };
+
+        static bytes default_credit_batch(const bytes burst) { return std::min(burst / 64, bytes(64 * 1024)); }
+
+        static std::atomic<std::uint64_t> &next_id()
+        {
+            static std::atomic<std::uint64_t> id{1};
+            return id;
+        }
+
+        [[nodiscard]] bool is_tiny(const std::uint64_t amount) const { return 4 * amount <= batch_bytes; }
+
+        // A few slots per thread, indexed by the identifier of the limiter. Identifiers are never reused, so the
+        // credit left by a destroyed limiter is simply dropped by the next owner of the slot.
+        credit &credit_slot() const
+        {
+            thread_local credit credits[8]{};
+            auto &slot{credits[id % 8]};
+            if (slot.limiter != id)
+                slot = credit{id, 0};
+            return slot;
+        }
+
+        [[nodiscard]] std::uint64_t nanoseconds_now() const
+        {
+            const auto elapsed{std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - epoch)};
+            return static_cast<std::uint64_t>(elapsed.count());
+        }
+
+        [[nodiscard]] cost cost_of(const std::uint64_t amount) const
+        {
+            const auto exact{static_cast<double>(amount) * nanoseconds_per_byte};
+            const auto whole{static_cast<std::uint64_t>(exact)};
+            return cost{whole, static_cast<std::uint64_t>((exact - static_cast<double>(whole)) * 4294967296.0)};
+        }
+
+        // Accumulates the fraction of a granted request and pushes the theoretical arrival time by the whole
+        // nanosecond it completes, if any.
+        void charge(const std::uint64_t fraction)
+        {
+            const auto before{carried_fraction.fetch_add(fraction, std::memory_order_relaxed)};
+            const auto carry{static_cast<std::uint32_t>(((before + fraction) >> 32) - (before >> 32))};
+            if (carry != 0)
+                theoretical_arrival.fetch_add(carry, std::memory_order_relaxed);
+        }
+
+        bool try_reserve(const std::uint64_t amount)
+        {
+            const auto now{nanoseconds_now()};
+            const auto price{cost_of(amount)};
+            auto tat{theoretical_arrival.load(std::memory_order_relaxed)};
+            while (true) {
+                const auto start{std::max(tat, now)};
+                if (start + price.whole - now > burst_nanoseconds && tat > now)
+                    return false;
+                if (theoretical_arrival.compare_exchange_weak(tat, start + price.whole, std::memory_order_relaxed)) {
+                    charge(price.fraction);
+                    return true;
+                }
+            }
+        }
+
+        // Reserves unconditionally and returns the time at which the reservation conforms.
+        std::uint64_t reserve(const std::uint64_t amount)
+        {
+            const auto now{nanoseconds_now()};
+            const auto price{cost_of(amount)};
+            auto tat{theoretical_arrival.load(std::memory_order_relaxed)};
+            while (!theoretical_arrival.compare_exchange_weak(tat, std::max(tat, now) + price.whole,
+                                                              std::memory_order_relaxed)) {
+            }
+            charge(price.fraction);
+            // Within the burst, the reservation conforms once it is no more than a burst ahead. Beyond, once the
+            // previous reservations are paid for.
+            const auto end{std::max(tat, now) + price.whole};
+            return end - std::min(end, std::max(price.whole, burst_nanoseconds));
+        }
+
+        void wait_for(const std::uint64_t nanoseconds) const
+        {
+            if (nanoseconds > nanoseconds_now())
+                std::this_thread::sleep_until(epoch + std::chrono::nanoseconds(nanoseconds));
+        }
+
+        const double bytes_per_second;
+        const double nanoseconds_per_byte;
+        const std::uint64_t burst_bytes;
+        const std::uint64_t burst_nanoseconds;
+        const std::uint64_t batch_bytes;
+        const clock::time_point epoch;
+        const std::uint64_t id;
+        std::atomic<std::uint64_t> theoretical_arrival{0};
+        std::atomic<std::uint64_t> carried_fraction{0};
+    };
+} // namespace mu
+
+#endif // MEMORY_UNITS_RATE_LIMITER_HPP
@@ -0,0 +1,231 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#ifndef MEMORY_UNITS_RECLAIMER_HPP
+#define MEMORY_UNITS_RECLAIMER_HPP
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include "memory_units.hpp"
+
+namespace mu
+{
+    enum class reclaim_policy {
+        priority,     // Lowest priority first, the largest footprint first among equal priorities
+        proportional, // Every component gives back in proportion to its footprint
+        lru_age       // Components holding the oldest entries first
+    };
+
+    struct reclaimer {
+        std::string name;
+        // Frees up to target bytes and returns how much was actually freed.
+        std::function<bytes(bytes)> reclaim;
+        std::function<bytes()> footprint;
+        int priority{0};
+        // Age of the least recently used entry, only needed by the lru_age policy.
+        std::function<std::chrono::steady_clock::duration()> oldest_entry_age{};
+    };
+
+    struct reclaim_report {
+        struct component {
+            std::uint64_t id;
+            std::string name;
+            bytes requested;
+            bytes freed;
+        };
+
+        bytes requested;
+        bytes freed;
+        std::vector<component> components;
+    };
+
+    // Coordinates the shrinking of every cache of the process when memory is short. The callbacks are run under a
+    // lock that remove() also takes, so that once remove() returns a component is never called again and may be
+    // destroyed. Calling reclaim(), enforce(), relieve(), footprint() or remove() from a callback deadlocks.
+    class reclaimer_registry {
+    public:
+        using handle = std::uint64_t;
+
+        handle add(reclaimer component)
+        {
+            std::lock_guard<std::mutex> lock(registration_mutex);
+            const auto id{++last_handle};
+            entries.push_back(std::make_shared<entry>(entry{id, std::move(component)}));
+            return id;
+        }
+
+        // Waits for a reclaim in progress to finish.
+        bool remove(const handle id)
+        {
+            std::lock_guard<std::mutex> reclaiming(reclaim_mutex);
+            std::lock_guard<std::mutex> lock(registration_mutex);
+            const auto it{std::find_if(entries.begin(), entries.end(),
+                                       [id](const std::shared_ptr<entry> &candidate) { return candidate->id == id; })};
+            if (it == entries.end())
+                return false;
+            entries.erase(it);
+            return true;
+        }
+
+        [[nodiscard]] std::size_t size() const
+        {
+            std::lock_guard<std::mutex> lock(registration_mutex);
+            return entries.size();
+        }
+
+        [[nodiscard]] bytes footprint() const
+        {
+            std::lock_guard<std::mutex> lock(reclaim_mutex);
+            auto total{bytes::zero()};
+            for (const auto &component : snapshot())
+                total += component->component.footprint();
+            return total;
+        }
+
+        template<typename Rep, typename Factor>
+        reclaim_report reclaim(const memory_size<Rep, Factor> &target, const reclaim_policy policy)
+        {
+            std::lock_guard<std::mutex> lock(reclaim_mutex);
+            const auto components{snapshot()};
+            std::vector<candidate> candidates;
+            candidates.reserve(components.size());
+            for (const auto &component : components)
+                candidates.push_back(candidate{component.get(), component->component.footprint()});
+            reclaim_report report{memory_size_cast<bytes>(target), bytes::zero(), {}};
+            switch (policy) {
+                case reclaim_policy::priority:
+                    std::stable_sort(candidates.begin(), candidates.end(), by_priority);
+                    break;
+                case reclaim_policy::lru_age:
+                    for (auto &entry : candidates)
+                        entry.age = entry.owner->component.oldest_entry_age
+                                            ? entry.owner->component.oldest_entry_age()
+                                            : std::chrono::steady_clock::duration::zero();
+                    std::stable_sort(candidates.begin(), candidates.end(),
+                                     [](const candidate &lhs, const candidate &rhs) { return lhs.age > rhs.age; });
+                    break;
+                case reclaim_policy::proportional:
+                    reclaim_proportionally(candidates, report);
+                    std::stable_sort(candidates.begin(), candidates.end(), by_priority);
+                    break;
+            }
+            // Sequential pass: for the ordered policies it does all the work, for the proportional one it covers
+            // what components could not free of their share.
+            for (auto &entry : candidates) {
+                if (report.freed >= report.requested)
+                    break;
+                const auto request{std::min(report.requested - report.freed, entry.footprint)};
+                if (request == bytes::zero())
+                    continue;
+                collect(entry, request, report);
+            }
+            return report;
+        }
+
+        // Shrinks the registered components back under a threshold.
+        template<typename Rep, typename Factor>
+        reclaim_report enforce(const memory_size<Rep, Factor> &threshold, const reclaim_policy policy)
+        {
+            const auto limit{memory_size_cast<bytes>(threshold)};
+            const auto used{footprint()};
+            return used > limit ? reclaim(used - limit, policy) : reclaim_report{bytes::zero(), bytes::zero(), {}};
+        }
+
+        // Sheds a fraction of the registered footprint, typically on an external memory pressure signal.
+        reclaim_report relieve(const double fraction, const reclaim_policy policy)
+        {
+            const auto clamped{std::min(std::max(fraction, 0.0), 1.0)};
+            return reclaim(bytes(static_cast<std::uint64_t>(static_cast<double>(footprint().count()) * clamped)),
+                           policy);
+        }
+
+    private:
+        struct entry {
+            handle id;
+            reclaimer component;
+        };
+
+        struct candidate {
+            const entry *owner;
+            bytes footprint;
+            std::chrono::steady_clock::duration age{};
+        };
+
+        static bool by_priority(const candidate &lhs, const candidate &rhs)
+        {
+            if (lhs.owner->component.priority != rhs.owner->component.priority)
+                return lhs.owner->component.priority < rhs.owner->component.priority;
+            return lhs.footprint > rhs.footprint;
+        }
+
+        static void collect(candidate &entry, const bytes request, reclaim_report &report)
+        {
+            const auto freed{std::min(entry.owner->component.reclaim(request), entry.footprint)};
+            entry.footprint -= freed;
+            report.freed += freed;
+            const auto it{std::find_if(report.components.begin(), report.components.end(),
+                                       [&entry](const reclaim_report::component &component) {
+                                           return component.id == entry.owner->id;
+                                       })};
+            if (it == report.components.end())
+                report.components.push_back(
+                        reclaim_report::component{entry.owner->id, entry.owner->component.name, request, freed});
+            else {
+                it->requested += request;
+                it->freed += freed;
+            }
+        }
+
+        static void reclaim_proportionally(std::vector<candidate> &candidates, reclaim_report &report)
+        {
+            auto total{bytes::zero()};
+            for (const auto &entry : candidates)
+                total += entry.footprint;
+            if (total == bytes::zero())
+                return;
+            const auto ratio{std::min(1.0, static_cast<double>(report.requested.count()) /
+                                                   static_cast<double>(total.count()))};
+            for (auto &entry : candidates) {
+                const bytes share(static_cast<std::uint64_t>(static_cast<double>(entry.footprint.count()) * ratio));
+                if (share > bytes::zero())
+                    collect(entry, share, report);
+            }
+        }
+
+        [[nodiscard]] std::vector<std::shared_ptr<entry>> snapshot() const
+        {
+            std::lock_guard<std::mutex> lock(registration_mutex);
+            return entries;
+        }
+
+        mutable std::mutex registration_mutex;
+        mutable std::mutex reclaim_mutex;
+        std::vector<std::shared_ptr<entry>> entries;
+        handle last_handle{0};
+    };
+} // namespace mu
+
+#endif // MEMORY_UNITS_RECLAIMER_HPP
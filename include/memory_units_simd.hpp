@@ -0,0 +1,459 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#ifndef MEMORY_UNITS_SIMD_HPP
+#define MEMORY_UNITS_SIMD_HPP
+#if !defined(__GNUC__)
+#error "The memory_units_simd.hpp header requires the vector extensions of GCC or Clang"
+#endif
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<experimental/simd>)
+#include <experimental/simd>
+#define MU_EXPERIMENTAL_SIMD 1
+#endif
+#endif
+#include "memory_units.hpp"
+
+namespace mu
+{
+    namespace details
+    {
+        template<std::size_t Size>
+        struct mask_lane {};
+
+        template<>
+        struct mask_lane<1> : identity<std::int8_t> {};
+
+        template<>
+        struct mask_lane<2> : identity<std::int16_t> {};
+
+        template<>
+        struct mask_lane<4> : identity<std::int32_t> {};
+
+        template<>
+        struct mask_lane<8> : identity<std::int64_t> {};
+    } // namespace details
+
+    // Result of a lane-wise comparison: every lane is either all ones or all zeros.
+    template<typename T, std::size_t N>
+    class simd_mask {
+    public:
+        using lane_type = typename details::mask_lane<sizeof(T)>::type;
+        typedef lane_type native_type __attribute__((vector_size(N * sizeof(T))));
+
+        constexpr simd_mask() = default;
+
+        constexpr explicit simd_mask(const native_type &lanes) : lanes(lanes) {}
+
+        [[nodiscard]] constexpr bool operator[](const std::size_t lane) const { return lanes[lane] != 0; }
+
+        [[nodiscard]] constexpr const native_type &native() const { return lanes; }
+
+        [[nodiscard]] static constexpr std::size_t size() { return N; }
+
+        friend constexpr simd_mask operator&&(const simd_mask &lhs, const simd_mask &rhs)
+        {
+            return simd_mask(lhs.lanes & rhs.lanes);
+        }
+
+        friend constexpr simd_mask operator||(const simd_mask &lhs, const simd_mask &rhs)
+        {
+            return simd_mask(lhs.lanes | rhs.lanes);
+        }
+
+        friend constexpr simd_mask operator!(const simd_mask &mask) { return simd_mask(~mask.lanes); }
+
+    private:
+        native_type lanes{};
+    };
+
+    template<typename T, std::size_t N>
+    [[nodiscard]] constexpr bool any_of(const simd_mask<T, N> &mask)
+    {
+        for (std::size_t lane{0}; lane < N; ++lane)
+            if (mask[lane])
+                return true;
+        return false;
+    }
+
+    template<typename T, std::size_t N>
+    [[nodiscard]] constexpr bool all_of(const simd_mask<T, N> &mask)
+    {
+        return !any_of(!mask);
+    }
+
+    template<typename T, std::size_t N>
+    [[nodiscard]] constexpr bool none_of(const simd_mask<T, N> &mask)
+    {
+        return !any_of(mask);
+    }
+
+    // N lanes of T in a vector register, usable as the representation of a memory_size for lane-wise arithmetic,
+    // casts and comparisons. Scalars are broadcast to every lane.
+    template<typename T, std::size_t N>
+    class simd {
+        static_assert(std::is_arithmetic<T>::value, "The lanes must be of an arithmetic type");
+        static_assert(N > 0 && (N & (N - 1)) == 0, "The number of lanes must be a power of two");
+
+    public:
+        using value_type = T;
+        using mask_type = simd_mask<T, N>;
+        typedef T native_type __attribute__((vector_size(N * sizeof(T))));
+
+        constexpr simd() = default;
+
+        template<typename U, typename = details::Precondition<std::is_arithmetic<U>::value>>
+        constexpr simd(const U value) : lanes(native_type{} + static_cast<T>(value))
+        {
+        }
+
+        template<typename... U, typename = details::Precondition<(N > 1 && sizeof...(U) == N)>>
+        constexpr simd(const U... values) : lanes{static_cast<T>(values)...}
+        {
+        }
+
+        template<typename U>
+        constexpr explicit simd(const simd<U, N> &other) :
+            lanes(__builtin_convertvector(other.native(), native_type))
+        {
+        }
+
+        constexpr explicit simd(const native_type &lanes) : lanes(lanes) {}
+
+        static simd load(const T *const data)
+        {
+            simd result;
+            std::memcpy(&result.lanes, data, sizeof(native_type));
+            return result;
+        }
+
+        void store(T *const data) const { std::memcpy(data, &lanes, sizeof(native_type)); }
+
+#if defined(MU_EXPERIMENTAL_SIMD)
+        explicit simd(const std::experimental::fixed_size_simd<T, N> &other)
+        {
+            T values[N];
+            other.copy_to(values, std::experimental::element_aligned);
+            *this = load(values);
+        }
+
+        [[nodiscard]] std::experimental::fixed_size_simd<T, N> to_experimental() const
+        {
+            T values[N];
+            store(values);
+            return std::experimental::fixed_size_simd<T, N>(values, std::experimental::element_aligned);
+        }
+#endif
+
+        [[nodiscard]] constexpr T operator[](const std::size_t lane) const { return lanes[lane]; }
+
+        [[nodiscard]] constexpr const native_type &native() const { return lanes; }
+
+        [[nodiscard]] static constexpr std::size_t size() { return N; }
+
+        constexpr simd operator+() const { return *this; }
+
+        constexpr simd operator-() const { return simd(-lanes); }
+
+        constexpr simd &operator+=(const simd &other)
+        {
+            lanes += other.lanes;
+            return *this;
+        }
+
+        constexpr simd &operator-=(const simd &other)
+        {
+            lanes -= other.lanes;
+            return *this;
+        }
+
+        constexpr simd &operator*=(const simd &other)
+        {
+            lanes *= other.lanes;
+            return *this;
+        }
+
+        constexpr simd &operator/=(const simd &other)
+        {
+            lanes /= other.lanes;
+            return *this;
+        }
+
+        constexpr simd &operator%=(const simd &other)
+        {
+            lanes %= other.lanes;
+            return *this;
+        }
+
+        friend constexpr simd operator+(const simd &lhs, const simd &rhs) { return simd(lhs.lanes + rhs.lanes); }
+
+        friend constexpr simd operator-(const simd &lhs, const simd &rhs) { return simd(lhs.lanes - rhs.lanes); }
+
+        friend constexpr simd operator*(const simd &lhs, const simd &rhs) { return simd(lhs.lanes * rhs.lanes); }
+
+        friend constexpr simd operator/(const simd &lhs, const simd &rhs) { return simd(lhs.lanes / rhs.lanes); }
+
+        friend constexpr simd operator%(const simd &lhs, const simd &rhs) { return simd(lhs.lanes % rhs.lanes); }
+
+        friend constexpr mask_type operator==(const simd &lhs, const simd &rhs)
+        {
+            return mask_type(lhs.lanes == rhs.lanes);
+        }
+
+        friend constexpr mask_type operator!=(const simd &lhs, const simd &rhs)
+        {
+            return mask_type(lhs.lanes != rhs.lanes);
+        }
+
+        friend constexpr mask_type operator<(const simd &lhs, const simd &rhs)
+        {
+            return mask_type(lhs.lanes < rhs.lanes);
+        }
+
+        friend constexpr mask_type operator<=(const simd &lhs, const simd &rhs)
+        {
+            return mask_type(lhs.lanes <= rhs.lanes);
+        }
+
+        friend constexpr mask_type operator>(const simd &lhs, const simd &rhs)
+        {
+            return mask_type(lhs.lanes > rhs.lanes);
+        }
+
+        friend constexpr mask_type operator>=(const simd &lhs, const simd &rhs)
+        {
+            return mask_type(lhs.lanes >= rhs.lanes);
+        }
+
+    private:
+        native_type lanes{};
+    };
+
+    // Lane-wise choice between two values, without branching.
+    template<typename T, std::size_t N>
+    [[nodiscard]] constexpr simd<T, N> select(const simd_mask<T, N> &mask, const simd<T, N> &lhs,
+                                              const simd<T, N> &rhs)
+    {
+        return simd<T, N>(mask.native() ? lhs.native() : rhs.native());
+    }
+
+    template<typename T, std::size_t N, typename Factor>
+    [[nodiscard]] constexpr memory_size<simd<T, N>, Factor> select(const simd_mask<T, N> &mask,
+                                                                 const memory_size<simd<T, N>, Factor> &lhs,
+                                                                 const memory_size<simd<T, N>, Factor> &rhs)
+    {
+        return memory_size<simd<T, N>, Factor>(select(mask, lhs.count(), rhs.count()));
+    }
+
+    namespace details
+    {
+        template<typename T, std::size_t N, typename Scalar, bool = std::is_arithmetic<Scalar>::value>
+        struct simd_scalar_common_type {};
+
+        template<typename T, std::size_t N, typename Scalar>
+        struct simd_scalar_common_type<T, N, Scalar, true> : identity<simd<common_type_t<T, Scalar>, N>> {};
+
+        template<typename Rep, typename Factor, typename OtherRep, typename OtherFactor>
+        using simd_comparison = typename memory_size_common_type<memory_size<Rep, Factor>,
+                                                                 memory_size<OtherRep, OtherFactor>>::type;
+    } // namespace details
+
+    // The comparisons of sizes over vectors return a mask, one lane per compared pair of sizes.
+    template<typename T, std::size_t N, typename Factor, typename U, typename OtherFactor>
+    constexpr auto operator==(const memory_size<simd<T, N>, Factor> &lhs,
+                              const memory_size<simd<U, N>, OtherFactor> &rhs)
+    {
+        using common_type = details::simd_comparison<simd<T, N>, Factor, simd<U, N>, OtherFactor>;
+        return common_type(lhs).count() == common_type(rhs).count();
+    }
+
+    template<typename T, std::size_t N, typename Factor, typename U, typename OtherFactor>
+    constexpr auto operator!=(const memory_size<simd<T, N>, Factor> &lhs,
+                              const memory_size<simd<U, N>, OtherFactor> &rhs)
+    {
+        using common_type = details::simd_comparison<simd<T, N>, Factor, simd<U, N>, OtherFactor>;
+        return common_type(lhs).count() != common_type(rhs).count();
+    }
+
+    template<typename T, std::size_t N, typename Factor, typename U, typename OtherFactor>
+    constexpr auto operator<(const memory_size<simd<T, N>, Factor> &lhs,
+                             const memory_size<simd<U, N>, OtherFactor> &rhs)
+    {
+        using common_type = details::simd_comparison<simd<T, N>, Factor, simd<U, N>, OtherFactor>;
+        return common_type(lhs).count() < common_type(rhs).count();
+    }
+
+    template<typename T, std::size_t N, typename Factor, typename U, typename OtherFactor>
+    constexpr auto operator<=(const memory_size<simd<T, N>, Factor> &lhs,
+                              const memory_size<simd<U, N>, OtherFactor> &rhs)
+    {
+        using common_type = details::simd_comparison<simd<T, N>, Factor, simd<U, N>, OtherFactor>;
+        return common_type(lhs).count() <= common_type(rhs).count();
+    }
+
+    template<typename T, std::size_t N, typename Factor, typename U, typename OtherFactor>
+    constexpr auto operator>(const memory_size<simd<T, N>, Factor> &lhs,
+                             const memory_size<simd<U, N>, OtherFactor> &rhs)
+    {
+        using common_type = details::simd_comparison<simd<T, N>, Factor, simd<U, N>, OtherFactor>;
+        return common_type(lhs).count() > common_type(rhs).count();
+    }
+
+    template<typename T, std::size_t N, typename Factor, typename U, typename OtherFactor>
+    constexpr auto operator>=(const memory_size<simd<T, N>, Factor> &lhs,
+                              const memory_size<simd<U, N>, OtherFactor> &rhs)
+    {
+        using common_type = details::simd_comparison<simd<T, N>, Factor, simd<U, N>, OtherFactor>;
+        return common_type(lhs).count() >= common_type(rhs).count();
+    }
+
+#if defined(MU_EXPERIMENTAL_SIMD)
+    // std::experimental::simd is a representation of memory_size as well. std::common_type cannot be specialized
+    // for it and its broadcast constructor rejects the intmax_t factors of memory_size_cast, so the common type and
+    // the conversions of its counts are given by the representation traits instead.
+    namespace details
+    {
+        template<typename T, typename Abi, typename Scalar, bool = std::is_arithmetic<Scalar>::value>
+        struct experimental_simd_scalar_common_type {};
+
+        template<typename T, typename Abi, typename Scalar>
+        struct experimental_simd_scalar_common_type<T, Abi, Scalar, true>
+            : identity<std::experimental::rebind_simd_t<common_type_t<T, Scalar>, std::experimental::simd<T, Abi>>> {
+        };
+
+        template<typename T, typename Abi>
+        struct rep_common_type<std::experimental::simd<T, Abi>, std::experimental::simd<T, Abi>>
+            : identity<std::experimental::simd<T, Abi>> {};
+
+        template<typename T, typename Abi, typename U, typename OtherAbi>
+        struct rep_common_type<std::experimental::simd<T, Abi>, std::experimental::simd<U, OtherAbi>>
+            : experimental_simd_scalar_common_type<T, Abi, U> {
+            static_assert(std::experimental::simd<T, Abi>::size() == std::experimental::simd<U, OtherAbi>::size(),
+                          "The vectors must have as many lanes");
+        };
+
+        template<typename T, typename Abi, typename Scalar>
+        struct rep_common_type<std::experimental::simd<T, Abi>, Scalar>
+            : experimental_simd_scalar_common_type<T, Abi, Scalar> {};
+
+        template<typename Scalar, typename T, typename Abi>
+        struct rep_common_type<Scalar, std::experimental::simd<T, Abi>>
+            : experimental_simd_scalar_common_type<T, Abi, Scalar> {};
+
+        // Scalars are converted to the type of the lanes before being broadcast.
+        template<typename T, typename Abi, typename From>
+        struct rep_converter<std::experimental::simd<T, Abi>, From> {
+            static std::experimental::simd<T, Abi> convert(const From &value)
+            {
+                return std::experimental::simd<T, Abi>(static_cast<T>(value));
+            }
+        };
+
+        template<typename T, typename Abi>
+        struct rep_converter<std::experimental::simd<T, Abi>, std::experimental::simd<T, Abi>> {
+            static std::experimental::simd<T, Abi> convert(const std::experimental::simd<T, Abi> &value)
+            {
+                return value;
+            }
+        };
+
+        template<typename T, typename Abi, typename U, typename OtherAbi>
+        struct rep_converter<std::experimental::simd<T, Abi>, std::experimental::simd<U, OtherAbi>> {
+            static std::experimental::simd<T, Abi> convert(const std::experimental::simd<U, OtherAbi> &value)
+            {
+                return std::experimental::static_simd_cast<std::experimental::simd<T, Abi>>(value);
+            }
+        };
+
+        template<typename T, typename Abi, typename Factor, typename U, typename OtherAbi, typename OtherFactor>
+        using experimental_simd_comparison =
+                simd_comparison<std::experimental::simd<T, Abi>, Factor, std::experimental::simd<U, OtherAbi>,
+                                OtherFactor>;
+    } // namespace details
+
+    template<typename T, typename Abi, typename Factor, typename U, typename OtherAbi, typename OtherFactor>
+    auto operator==(const memory_size<std::experimental::simd<T, Abi>, Factor> &lhs,
+                    const memory_size<std::experimental::simd<U, OtherAbi>, OtherFactor> &rhs)
+    {
+        using common_type = details::experimental_simd_comparison<T, Abi, Factor, U, OtherAbi, OtherFactor>;
+        return common_type(lhs).count() == common_type(rhs).count();
+    }
+
+    template<typename T, typename Abi, typename Factor, typename U, typename OtherAbi, typename OtherFactor>
+    auto operator!=(const memory_size<std::experimental::simd<T, Abi>, Factor> &lhs,
+                    const memory_size<std::experimental::simd<U, OtherAbi>, OtherFactor> &rhs)
+    {
+        using common_type = details::experimental_simd_comparison<T, Abi, Factor, U, OtherAbi, OtherFactor>;
+        return common_type(lhs).count() != common_type(rhs).count();
+    }
+
+    template<typename T, typename Abi, typename Factor, typename U, typename OtherAbi, typename OtherFactor>
+    auto operator<(const memory_size<std::experimental::simd<T, Abi>, Factor> &lhs,
+                   const memory_size<std::experimental::simd<U, OtherAbi>, OtherFactor> &rhs)
+    {
+        using common_type = details::experimental_simd_comparison<T, Abi, Factor, U, OtherAbi, OtherFactor>;
+        return common_type(lhs).count() < common_type(rhs).count();
+    }
+
+    template<typename T, typename Abi, typename Factor, typename U, typename OtherAbi, typename OtherFactor>
+    auto operator<=(const memory_size<std::experimental::simd<T, Abi>, Factor> &lhs,
+                    const memory_size<std::experimental::simd<U, OtherAbi>, OtherFactor> &rhs)
+    {
+        using common_type = details::experimental_simd_comparison<T, Abi, Factor, U, OtherAbi, OtherFactor>;
+        return common_type(lhs).count() <= common_type(rhs).count();
+    }
+
+    template<typename T, typename Abi, typename Factor, typename U, typename OtherAbi, typename OtherFactor>
+    auto operator>(const memory_size<std::experimental::simd<T, Abi>, Factor> &lhs,
+                   const memory_size<std::experimental::simd<U, OtherAbi>, OtherFactor> &rhs)
+    {
+        using common_type = details::experimental_simd_comparison<T, Abi, Factor, U, OtherAbi, OtherFactor>;
+        return common_type(lhs).count() > common_type(rhs).count();
+    }
+
+    template<typename T, typename Abi, typename Factor, typename U, typename OtherAbi, typename OtherFactor>
+    auto operator>=(const memory_size<std::experimental::simd<T, Abi>, Factor> &lhs,
+                    const memory_size<std::experimental::simd<U, OtherAbi>, OtherFactor> &rhs)
+    {
+        using common_type = details::experimental_simd_comparison<T, Abi, Factor, U, OtherAbi, OtherFactor>;
+        return common_type(lhs).count() >= common_type(rhs).count();
+    }
+#endif
+} // namespace mu
+
+namespace std
+{
+    template<typename T, typename U, std::size_t N>
+    struct common_type<mu::simd<T, N>, mu::simd<U, N>> {
+        using type = mu::simd<typename common_type<T, U>::type, N>;
+    };
+
+    template<typename T, std::size_t N, typename Scalar>
+    struct common_type<mu::simd<T, N>, Scalar> : mu::details::simd_scalar_common_type<T, N, Scalar> {};
+
+    template<typename Scalar, typename T, std::size_t N>
+    struct common_type<Scalar, mu::simd<T, N>> : mu::details::simd_scalar_common_type<T, N, Scalar> {};
+} // namespace std
+
+#endif // MEMORY_UNITS_SIMD_HPP
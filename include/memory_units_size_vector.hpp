@@ -0,0 +1,342 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#ifndef MEMORY_UNITS_SIZE_VECTOR_HPP
+#define MEMORY_UNITS_SIZE_VECTOR_HPP
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <vector>
+#include "memory_units.hpp"
+
+namespace mu
+{
+    namespace details
+    {
+        // Allocator over-aligning its blocks, e.g. on a cache line so that vector loads never split one. The
+        // address returned by operator new is kept right before the aligned block.
+        template<typename T, std::size_t Alignment>
+        struct aligned_allocator {
+            static_assert(Alignment >= alignof(void *) && (Alignment & (Alignment - 1)) == 0,
+                          "The alignment must be a power of two at least as large as a pointer");
+
+            using value_type = T;
+
+            template<typename U>
+            struct rebind {
+                using other = aligned_allocator<U, Alignment>;
+            };
+
+            aligned_allocator() = default;
+
+            template<typename U>
+            aligned_allocator(const aligned_allocator<U, Alignment> &) noexcept
+            {
+            }
+
+            T *allocate(const std::size_t count)
+            {
+                constexpr auto overhead{Alignment - 1 + sizeof(void *)};
+                if (count > (std::numeric_limits<std::size_t>::max() - overhead) / sizeof(T))
+                    throw std::bad_alloc();
+                const auto raw{::operator new(count * sizeof(T) + overhead)};
+                const auto aligned{(reinterpret_cast<std::uintptr_t>(raw) + overhead) & ~(Alignment - 1)};
+                reinterpret_cast<void **>(aligned)[-1] = raw;
+                return reinterpret_cast<T *>(aligned);
+            }
+
+            void deallocate(T *const pointer, std::size_t) noexcept
+            {
+                ::operator delete(reinterpret_cast<void **>(pointer)[-1]);
+            }
+
+            template<typename U>
+            bool operator==(const aligned_allocator<U, Alignment> &) const noexcept
+            {
+                return true;
+            }
+
+            template<typename U>
+            bool operator!=(const aligned_allocator<U, Alignment> &) const noexcept
+            {
+                return false;
+            }
+        };
+
+        // Random access iterator over raw counts of a unit, yielding them as memory sizes of another unit.
+        template<typename To, typename Rep, typename Factor>
+        class converting_iterator {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = To;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = To;
+
+            constexpr converting_iterator() = default;
+
+            constexpr explicit converting_iterator(const Rep *const position) : position(position) {}
+
+            constexpr To operator*() const { return memory_size_cast<To>(memory_size<Rep, Factor>(*position)); }
+
+            constexpr To operator[](const difference_type offset) const { return *(*this + offset); }
+
+            constexpr converting_iterator &operator++()
+            {
+                ++position;
+                return *this;
+            }
+
+            constexpr converting_iterator operator++(int) { return converting_iterator(position++); }
+
+            constexpr converting_iterator &operator--()
+            {
+                --position;
+                return *this;
+            }
+
+            constexpr converting_iterator operator--(int) { return converting_iterator(position--); }
+
+            constexpr converting_iterator &operator+=(const difference_type offset)
+            {
+                position += offset;
+                return *this;
+            }
+
+            constexpr converting_iterator &operator-=(const difference_type offset)
+            {
+                position -= offset;
+                return *this;
+            }
+
+            friend constexpr converting_iterator operator+(converting_iterator it, const difference_type offset)
+            {
+                return it += offset;
+            }
+
+            friend constexpr converting_iterator operator+(const difference_type offset, converting_iterator it)
+            {
+                return it += offset;
+            }
+
+            friend constexpr converting_iterator operator-(converting_iterator it, const difference_type offset)
+            {
+                return it -= offset;
+            }
+
+            friend constexpr difference_type operator-(const converting_iterator &lhs, const converting_iterator &rhs)
+            {
+                return lhs.position - rhs.position;
+            }
+
+            friend constexpr bool operator==(const converting_iterator &lhs, const converting_iterator &rhs)
+            {
+                return lhs.position == rhs.position;
+            }
+
+            friend constexpr bool operator!=(const converting_iterator &lhs, const converting_iterator &rhs)
+            {
+                return lhs.position != rhs.position;
+            }
+
+            friend constexpr bool operator<(const converting_iterator &lhs, const converting_iterator &rhs)
+            {
+                return lhs.position < rhs.position;
+            }
+
+            friend constexpr bool operator>(const converting_iterator &lhs, const converting_iterator &rhs)
+            {
+                return lhs.position > rhs.position;
+            }
+
+            friend constexpr bool operator<=(const converting_iterator &lhs, const converting_iterator &rhs)
+            {
+                return lhs.position <= rhs.position;
+            }
+
+            friend constexpr bool operator>=(const converting_iterator &lhs, const converting_iterator &rhs)
+            {
+                return lhs.position >= rhs.position;
+            }
+
+        private:
+            const Rep *position{nullptr};
+        };
+    } // namespace details
+
+    // Lazy view over raw counts of a unit, converting each element to another unit with memory_size_cast when it
+    // is accessed. It does not own the counts and is invalidated like an iterator of the viewed container.
+    template<typename To, typename Rep, typename Factor>
+    class size_view {
+    public:
+        using value_type = To;
+        using iterator = details::converting_iterator<To, Rep, Factor>;
+        using const_iterator = iterator;
+
+        constexpr size_view(const Rep *const first, const std::size_t count) : first(first), count(count) {}
+
+        [[nodiscard]] constexpr iterator begin() const { return iterator(first); }
+
+        [[nodiscard]] constexpr iterator end() const { return iterator(first + count); }
+
+        [[nodiscard]] constexpr To operator[](const std::size_t index) const { return begin()[index]; }
+
+        [[nodiscard]] constexpr std::size_t size() const { return count; }
+
+        [[nodiscard]] constexpr bool empty() const { return count == 0; }
+
+    private:
+        const Rep *first;
+        std::size_t count;
+    };
+
+    // Contiguous sequence of memory sizes of a single unit, stored as raw counts on cache line aligned storage so
+    // that kernels can work on data() directly. Elements are read as memory sizes, or as sizes of another unit
+    // through view_as(), without copying.
+    template<typename Factor, typename Rep = INT_UNIT_TYPE>
+    class size_vector {
+    public:
+        using value_type = memory_size<Rep, Factor>;
+        using rep = Rep;
+        using factor = Factor;
+        using const_iterator = details::converting_iterator<value_type, Rep, Factor>;
+        using iterator = const_iterator;
+
+        static constexpr std::size_t alignment{64};
+
+        size_vector() = default;
+
+        explicit size_vector(const std::size_t count) : counts(count) {}
+
+        template<typename InputIt>
+        size_vector(InputIt first, const InputIt last)
+        {
+            append(first, last);
+        }
+
+        template<typename OtherRep, typename OtherFactor>
+        void push_back(const memory_size<OtherRep, OtherFactor> &size)
+        {
+            counts.push_back(value_type(size).count());
+        }
+
+        // Appends sizes of any unit exactly convertible to the unit of the vector. Contiguous ranges are converted
+        // in a single loop over the reserved storage.
+        template<typename InputIt>
+        void append(InputIt first, const InputIt last)
+        {
+            append(first, last, typename std::iterator_traits<InputIt>::iterator_category{});
+        }
+
+        template<typename OtherFactor, typename OtherRep>
+        void append(const size_vector<OtherFactor, OtherRep> &other)
+        {
+            append(other.begin(), other.end());
+        }
+
+        template<typename OtherRep, typename OtherFactor>
+        void set(const std::size_t index, const memory_size<OtherRep, OtherFactor> &size)
+        {
+            counts[index] = value_type(size).count();
+        }
+
+        [[nodiscard]] value_type operator[](const std::size_t index) const { return value_type(counts[index]); }
+
+        [[nodiscard]] value_type front() const { return value_type(counts.front()); }
+
+        [[nodiscard]] value_type back() const { return value_type(counts.back()); }
+
+        [[nodiscard]] const_iterator begin() const { return const_iterator(counts.data()); }
+
+        [[nodiscard]] const_iterator end() const { return const_iterator(counts.data() + counts.size()); }
+
+        template<typename To>
+        [[nodiscard]] details::Precondition<details::is_memory_size<To>::value, size_view<To, Rep, Factor>>
+        view_as() const
+        {
+            return size_view<To, Rep, Factor>(counts.data(), counts.size());
+        }
+
+        [[nodiscard]] Rep *data() { return counts.data(); }
+
+        [[nodiscard]] const Rep *data() const { return counts.data(); }
+
+        [[nodiscard]] std::size_t size() const { return counts.size(); }
+
+        [[nodiscard]] bool empty() const { return counts.empty(); }
+
+        [[nodiscard]] std::size_t capacity() const { return counts.capacity(); }
+
+        [[nodiscard]] bytes footprint() const { return bytes(counts.capacity() * sizeof(Rep)); }
+
+        void reserve(const std::size_t count) { counts.reserve(count); }
+
+        void resize(const std::size_t count) { counts.resize(count); }
+
+        void pop_back() { counts.pop_back(); }
+
+        void clear() { counts.clear(); }
+
+    private:
+        template<typename InputIt>
+        void append(InputIt first, const InputIt last, std::input_iterator_tag)
+        {
+            for (; first != last; ++first)
+                push_back(*first);
+        }
+
+        // The range may lie in the vector itself, so its current storage is kept alive until every size is read.
+        template<typename ForwardIt>
+        void append(ForwardIt first, const ForwardIt last, std::forward_iterator_tag)
+        {
+            const auto offset{counts.size()};
+            const auto count{static_cast<std::size_t>(std::distance(first, last))};
+            if (offset + count <= counts.capacity()) {
+                counts.resize(offset + count);
+                convert(first, last, counts.data() + offset);
+                return;
+            }
+            decltype(counts) grown;
+            grown.reserve(std::max(offset + count, 2 * counts.capacity()));
+            grown.assign(counts.cbegin(), counts.cend());
+            grown.resize(offset + count);
+            convert(first, last, grown.data() + offset);
+            counts.swap(grown);
+        }
+
+        template<typename ForwardIt>
+        static void convert(ForwardIt first, const ForwardIt last, Rep *out)
+        {
+            for (; first != last; ++first, ++out)
+                *out = value_type(*first).count();
+        }
+
+        std::vector<Rep, details::aligned_allocator<Rep, alignment>> counts;
+    };
+
+    template<typename Factor, typename Rep>
+    constexpr std::size_t size_vector<Factor, Rep>::alignment;
+} // namespace mu
+
+#endif // MEMORY_UNITS_SIZE_VECTOR_HPP
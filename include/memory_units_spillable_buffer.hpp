@@ -0,0 +1,170 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#ifndef MEMORY_UNITS_SPILLABLE_BUFFER_HPP
+#define MEMORY_UNITS_SPILLABLE_BUFFER_HPP
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <system_error>
+#include <vector>
+#include "memory_units_posix.hpp"
+
+namespace mu
+{
+    namespace details
+    {
+        // Anonymous file that never appears in the directory on Linux, falling back to a file unlinked right after
+        // its creation on file systems or kernels without O_TMPFILE.
+        inline file_descriptor open_anonymous_file(const std::string &directory)
+        {
+#if defined(O_TMPFILE)
+            file_descriptor file(::open(directory.c_str(), O_TMPFILE | O_RDWR | O_CLOEXEC, 0600));
+            if (file.valid())
+                return file;
+#endif
+            return create_temporary_file(directory);
+        }
+    } // namespace details
+
+    // Append-only byte buffer held in memory up to a threshold. Past the threshold, its content moves to an
+    // anonymous file and the next appends go there through a small staging buffer. The content is read back
+    // without copy, from the memory or from a read-only mapping of the file.
+    class spillable_buffer {
+    public:
+        class view {
+        public:
+            view() = default;
+
+            view(const char *const data, const std::size_t size) : pointer(data), length(size) {}
+
+            [[nodiscard]] const char *data() const { return pointer; }
+
+            [[nodiscard]] std::size_t size() const { return length; }
+
+            [[nodiscard]] bool empty() const { return length == 0; }
+
+            [[nodiscard]] const char *begin() const { return pointer; }
+
+            [[nodiscard]] const char *end() const { return pointer + length; }
+
+        private:
+            const char *pointer{nullptr};
+            std::size_t length{0};
+        };
+
+        template<typename Rep, typename Factor>
+        explicit spillable_buffer(const memory_size<Rep, Factor> &threshold, std::string directory = "/tmp") :
+            threshold(static_cast<std::size_t>(memory_size_cast<bytes>(threshold).count())),
+            directory(std::move(directory))
+        {
+        }
+
+        void append(const void *const data, const std::size_t size)
+        {
+            const auto bytes_to_append{static_cast<const char *>(data)};
+            if (!spilled() && memory.size() + size > threshold)
+                spill();
+            if (!spilled()) {
+                // Grow geometrically, but never past the threshold.
+                if (memory.size() + size > memory.capacity())
+                    memory.reserve(std::min(threshold, std::max(2 * memory.capacity(), memory.size() + size)));
+                memory.insert(memory.end(), bytes_to_append, bytes_to_append + size);
+                return;
+            }
+            if (staged.size() + size > staging_size)
+                flush();
+            if (size >= staging_size)
+                details::write_all(file, bytes_to_append, size);
+            else
+                staged.insert(staged.end(), bytes_to_append, bytes_to_append + size);
+            length += size;
+        }
+
+        void append(const std::string &data) { append(data.data(), data.size()); }
+
+        // Zero-copy view of the whole content, valid until the next append or clear.
+        [[nodiscard]] view read() const
+        {
+            if (!spilled())
+                return view(memory.data(), memory.size());
+            flush();
+            if (length == 0)
+                return view();
+            if (mapping.size() != length) {
+                mapping.reset();
+                const auto address{::mmap(nullptr, length, PROT_READ, MAP_SHARED, file.get(), 0)};
+                if (address == MAP_FAILED)
+                    throw std::system_error(errno, std::generic_category(), "Unable to map the spilled buffer");
+                mapping = details::memory_mapping(address, length);
+            }
+            return view(static_cast<const char *>(mapping.get()), length);
+        }
+
+        [[nodiscard]] bool spilled() const { return file.valid(); }
+
+        [[nodiscard]] bytes size() const { return bytes(spilled() ? length : memory.size()); }
+
+        [[nodiscard]] bytes threshold_size() const { return bytes(threshold); }
+
+        // Heap memory held by the buffer. The pages of the file mapping belong to the page cache and are not counted.
+        [[nodiscard]] bytes memory_footprint() const { return bytes(memory.capacity() + staged.capacity()); }
+
+        [[nodiscard]] bytes disk_footprint() const { return bytes(spilled() ? length - staged.size() : 0); }
+
+        // Drops the content and the spill file, going back to memory.
+        void clear()
+        {
+            mapping.reset();
+            file.reset();
+            std::vector<char>().swap(staged);
+            memory.clear();
+            length = 0;
+        }
+
+    private:
+        static constexpr std::size_t staging_size{64 * 1024};
+
+        void spill()
+        {
+            file = details::open_anonymous_file(directory);
+            details::write_all(file, memory.data(), memory.size());
+            length = memory.size();
+            std::vector<char>().swap(memory);
+            staged.reserve(staging_size);
+        }
+
+        void flush() const
+        {
+            details::write_all(file, staged.data(), staged.size());
+            staged.clear();
+        }
+
+        const std::size_t threshold;
+        const std::string directory;
+        std::vector<char> memory;
+        details::file_descriptor file;
+        std::size_t length{0};
+        mutable std::vector<char> staged;
+        mutable details::memory_mapping mapping;
+    };
+} // namespace mu
+
+#endif // MEMORY_UNITS_SPILLABLE_BUFFER_HPP
@@ -0,0 +1,236 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#ifndef MEMORY_UNITS_TRANSFER_METER_HPP
+#define MEMORY_UNITS_TRANSFER_METER_HPP
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include "memory_units_rate.hpp"
+
+namespace mu
+{
+    struct transfer_snapshot {
+        bytes transferred;
+        bytes total;
+        std::chrono::steady_clock::duration elapsed;
+        f_bytes_per_second average_rate; // Since the start
+        f_bytes_per_second ewma_rate;    // Exponentially weighted, favoring the recent samples
+        f_bytes_per_second window_rate;  // Over the sliding window
+        std::chrono::duration<double> eta; // max() while unknown: no rate yet or no total
+
+        // Fraction of the total transferred, 0 when the total is unknown.
+        [[nodiscard]] double progress() const
+        {
+            return total == bytes::zero() ? 0.0
+                                           : std::min(1.0, static_cast<double>(transferred.count()) /
+                                                                   static_cast<double>(total.count()));
+        }
+    };
+
+    // Progress and throughput of a transfer fed by many threads. Each thread adds to its own counter shard with a
+    // relaxed increment. Snapshots sum the shards, refresh the rates when a sampling interval has elapsed and
+    // publish them through a sequence lock, so that readers never block and never wait for the writers.
+    class transfer_meter {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        template<typename Rep, typename Factor>
+        explicit transfer_meter(const memory_size<Rep, Factor> &total,
+                                const clock::duration window = std::chrono::seconds(10),
+                                const clock::duration half_life = std::chrono::seconds(3),
+                                const clock::time_point start = clock::now(), const std::size_t shard_count = 16) :
+            total_bytes(memory_size_cast<bytes>(total).count()), window(window),
+            sample_interval(window / (window_samples - 1)),
+            time_constant(std::chrono::duration<double>(half_life).count() / std::log(2.0)), start(start),
+            mask(round_up_power_of_two(shard_count) - 1), shards(new shard[mask + 1])
+        {
+            if (window <= clock::duration::zero() || half_life <= clock::duration::zero())
+                throw std::invalid_argument("The window and the half-life of a transfer meter must be positive");
+            samples[0] = sample{clock::duration::zero(), 0};
+        }
+
+        transfer_meter() : transfer_meter(bytes::zero()) {}
+
+        transfer_meter(const transfer_meter &) = delete;
+
+        transfer_meter &operator=(const transfer_meter &) = delete;
+
+        template<typename Rep, typename Factor>
+        void add(const memory_size<Rep, Factor> &size)
+        {
+            shards[shard_index() & mask].value.fetch_add(memory_size_cast<bytes>(size).count(),
+                                                         std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] bytes transferred() const
+        {
+            std::uint64_t sum{0};
+            for (std::size_t i{0}; i <= mask; ++i)
+                sum += shards[i].value.load(std::memory_order_relaxed);
+            return bytes(sum);
+        }
+
+        [[nodiscard]] bytes total() const { return bytes(total_bytes); }
+
+        transfer_snapshot snapshot() { return snapshot(clock::now()); }
+
+        transfer_snapshot snapshot(const clock::time_point now)
+        {
+            const auto done{transferred()};
+            const auto elapsed{now - start};
+            if (elapsed - last_sample_time.load(std::memory_order_relaxed) >= sample_interval &&
+                !updating.exchange(true, std::memory_order_acquire)) {
+                update(elapsed, done.count());
+                updating.store(false, std::memory_order_release);
+            }
+            const auto rates{read_rates()};
+            const auto seconds{std::chrono::duration<double>(elapsed).count()};
+            transfer_snapshot result{done,
+                                     bytes(total_bytes),
+                                     elapsed,
+                                     f_bytes_per_second(seconds > 0 ? static_cast<double>(done.count()) / seconds
+                                                                    : 0.0),
+                                     f_bytes_per_second(rates.ewma),
+                                     f_bytes_per_second(rates.window),
+                                     std::chrono::duration<double>::max()};
+            if (total_bytes != 0 && done.count() >= total_bytes)
+                result.eta = std::chrono::duration<double>::zero();
+            else if (total_bytes != 0 && rates.ewma > 0)
+                result.eta = f_bytes(static_cast<double>(total_bytes - done.count())) / result.ewma_rate;
+            return result;
+        }
+
+    private:
+        static constexpr std::size_t window_samples{33};
+        static constexpr std::size_t cache_line{64};
+
+        struct shard {
+            std::atomic<std::uint64_t> value{0};
+            char padding[cache_line - sizeof(std::atomic<std::uint64_t>)];
+        };
+
+        struct sample {
+            clock::duration time;
+            std::uint64_t transferred;
+        };
+
+        struct rates {
+            double ewma;
+            double window;
+        };
+
+        static std::size_t round_up_power_of_two(const std::size_t value)
+        {
+            std::size_t result{1};
+            while (result < value)
+                result <<= 1;
+            return result;
+        }
+
+        static std::size_t shard_index()
+        {
+            static std::atomic<std::size_t> next{0};
+            thread_local const auto index{next.fetch_add(1, std::memory_order_relaxed)};
+            return index;
+        }
+
+        static std::uint64_t to_bits(const double value)
+        {
+            std::uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+
+        static double from_bits(const std::uint64_t bits)
+        {
+            double value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        // Only one thread at a time gets here, but possibly with a time or a count older than the last sample taken
+        // by another thread since the interval was checked. Such stale samples are dropped.
+        void update(const clock::duration elapsed, const std::uint64_t done)
+        {
+            const auto &previous{samples[newest % window_samples]};
+            if (elapsed - previous.time < sample_interval || done < previous.transferred)
+                return;
+            const auto delta{std::chrono::duration<double>(elapsed - previous.time).count()};
+            const auto instant{static_cast<double>(done - previous.transferred) / delta};
+            ewma = newest == 0 ? instant : ewma + (1 - std::exp(-delta / time_constant)) * (instant - ewma);
+
+            ++newest;
+            samples[newest % window_samples] = sample{elapsed, done};
+            // The oldest sample still inside the window
+            auto oldest{newest > window_samples - 1 ? newest - (window_samples - 1) : 0};
+            while (oldest + 1 < newest && elapsed - samples[oldest % window_samples].time > window)
+                ++oldest;
+            const auto &first{samples[oldest % window_samples]};
+            const auto span{std::chrono::duration<double>(elapsed - first.time).count()};
+            const auto windowed{span > 0 ? static_cast<double>(done - first.transferred) / span : 0.0};
+
+            sequence.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            published_ewma.store(to_bits(ewma), std::memory_order_relaxed);
+            published_window.store(to_bits(windowed), std::memory_order_relaxed);
+            sequence.fetch_add(1, std::memory_order_release);
+            last_sample_time.store(elapsed, std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] rates read_rates() const
+        {
+            while (true) {
+                const auto before{sequence.load(std::memory_order_acquire)};
+                const auto ewma_bits{published_ewma.load(std::memory_order_relaxed)};
+                const auto window_bits{published_window.load(std::memory_order_relaxed)};
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if ((before & 1) == 0 && sequence.load(std::memory_order_relaxed) == before)
+                    return rates{from_bits(ewma_bits), from_bits(window_bits)};
+            }
+        }
+
+        const std::uint64_t total_bytes;
+        const clock::duration window;
+        const clock::duration sample_interval;
+        const double time_constant;
+        const clock::time_point start;
+        const std::size_t mask;
+        std::unique_ptr<shard[]> shards;
+
+        std::atomic<bool> updating{false};
+        std::atomic<clock::duration> last_sample_time{clock::duration::zero()};
+        std::atomic<std::uint64_t> sequence{0};
+        std::atomic<std::uint64_t> published_ewma{0};
+        std::atomic<std::uint64_t> published_window{0};
+
+        sample samples[window_samples];
+        std::size_t newest{0};
+        double ewma{0};
+    };
+} // namespace mu
+
+#endif // MEMORY_UNITS_TRANSFER_METER_HPP
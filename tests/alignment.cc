@@ -0,0 +1,128 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include "memory_units.hpp"
+#if defined(__unix__)
+#include "memory_units_posix.hpp"
+#endif
+
+using namespace mu::literals;
+
+TEST(Alignment, HardwareUnits)
+{
+    EXPECT_EQ(mu::sectors(1), 512_B);
+    EXPECT_EQ(mu::cache_lines(1), 64_B);
+    EXPECT_EQ(mu::pages(1), 4_kiB);
+    EXPECT_EQ(mu::huge_pages(1), 2_MiB);
+    EXPECT_EQ(mu::memory_size_cast<mu::pages>(1_GiB).count(), 262144u);
+    EXPECT_EQ(mu::memory_size_cast<mu::sectors>(mu::huge_pages(3)).count(), 12288u);
+    static_assert(mu::pages(512) == mu::huge_pages(1), "A huge page holds 512 pages");
+}
+
+TEST(Alignment, AlignsUpToPowerOfTwoUnits)
+{
+    static_assert(mu::align_up<mu::pages>(10_kiB) == 12_kiB, "Rounded to the next page");
+    EXPECT_EQ(mu::align_up<mu::pages>(0_B), 0_B);
+    EXPECT_EQ(mu::align_up<mu::pages>(1_B), 4_kiB);
+    EXPECT_EQ(mu::align_up<mu::pages>(4_kiB), 4_kiB);
+    EXPECT_EQ(mu::align_up<mu::cache_lines>(65_B), 128_B);
+    EXPECT_EQ(mu::align_up<mu::huge_pages>(3_MiB), 4_MiB);
+    EXPECT_EQ(mu::align_up<mu::sectors>(1_kB), 1_kiB);
+    const auto aligned{mu::align_up<mu::pages>(1_MiB)};
+    EXPECT_TRUE((std::is_same<decltype(aligned), const mu::pages>::value));
+    EXPECT_EQ(aligned.count(), 256u);
+}
+
+TEST(Alignment, AlignsDownToPowerOfTwoUnits)
+{
+    static_assert(mu::align_down<mu::pages>(10_kiB) == 8_kiB, "Rounded to the previous page");
+    EXPECT_EQ(mu::align_down<mu::cache_lines>(127_B), 64_B);
+    EXPECT_EQ(mu::align_down<mu::cache_lines>(63_B), 0_B);
+    EXPECT_EQ(mu::align_down<mu::huge_pages>(5_MiB), 4_MiB);
+}
+
+TEST(Alignment, ChecksAlignment)
+{
+    static_assert(mu::is_aligned<mu::pages>(8_kiB), "Two pages");
+    EXPECT_FALSE(mu::is_aligned<mu::pages>(6_kiB));
+    EXPECT_TRUE(mu::is_aligned<mu::cache_lines>(mu::pages(3)));
+    EXPECT_FALSE(mu::is_aligned<mu::huge_pages>(mu::pages(3)));
+    EXPECT_TRUE(mu::is_aligned<mu::sectors>(0_B));
+}
+
+TEST(Alignment, AlignsToUnitsThatAreNotPowersOfTwo)
+{
+    EXPECT_EQ(mu::align_up<mu::kilobytes>(1_kiB), 2_kB);
+    EXPECT_EQ(mu::align_down<mu::kilobytes>(1_kiB), 1_kB);
+    EXPECT_FALSE(mu::is_aligned<mu::kilobytes>(1_kiB));
+    EXPECT_TRUE(mu::is_aligned<mu::kilobytes>(3_MB));
+}
+
+TEST(Alignment, AlignsToRuntimeUnits)
+{
+    const mu::bytes page(4096);
+    EXPECT_EQ(mu::align_up(10_kiB, page), 12_kiB);
+    EXPECT_EQ(mu::align_down(10_kiB, page), 8_kiB);
+    EXPECT_TRUE(mu::is_aligned(8_kiB, page));
+    EXPECT_FALSE(mu::is_aligned(9_kiB, page));
+    EXPECT_EQ(mu::align_up(1001_B, mu::bytes(1000)), 2000_B);
+    EXPECT_EQ(mu::align_down(1999_B, mu::bytes(1000)), 1000_B);
+}
+
+TEST(Alignment, RejectsAlignmentsThatAreNotPositive)
+{
+    using signed_bytes = mu::memory_size<std::int64_t, std::ratio<1>>;
+    EXPECT_THROW(mu::align_up(10_kiB, mu::bytes(0)), std::invalid_argument);
+    EXPECT_THROW(mu::align_down(10_kiB, mu::bytes(0)), std::invalid_argument);
+    EXPECT_THROW(mu::is_aligned(10_kiB, mu::bytes(0)), std::invalid_argument);
+    EXPECT_THROW(mu::align_up(signed_bytes(10), signed_bytes(-4)), std::invalid_argument);
+}
+
+TEST(Alignment, RoundsNegativeSizesTheSameWayForEveryAlignment)
+{
+    using signed_bytes = mu::memory_size<std::int64_t, std::ratio<1>>;
+    EXPECT_EQ(mu::align_down(signed_bytes(-5), signed_bytes(4)), signed_bytes(-8));
+    EXPECT_EQ(mu::align_down(signed_bytes(-5), signed_bytes(3)), signed_bytes(-6));
+    EXPECT_EQ(mu::align_up(signed_bytes(-5), signed_bytes(4)), signed_bytes(-4));
+    EXPECT_EQ(mu::align_up(signed_bytes(-5), signed_bytes(3)), signed_bytes(-3));
+    EXPECT_EQ(mu::align_up(signed_bytes(-6), signed_bytes(3)), signed_bytes(-6));
+    EXPECT_EQ(mu::align_down(signed_bytes(-6), signed_bytes(3)), signed_bytes(-6));
+    for (std::int64_t value{-20}; value <= 20; ++value) {
+        for (const std::int64_t alignment : {1, 3, 4, 6, 8}) {
+            const auto down{mu::align_down(signed_bytes(value), signed_bytes(alignment)).count()};
+            const auto up{mu::align_up(signed_bytes(value), signed_bytes(alignment)).count()};
+            EXPECT_TRUE(down <= value && value < down + alignment) << value << " " << alignment;
+            EXPECT_TRUE(up >= value && value > up - alignment) << value << " " << alignment;
+            EXPECT_EQ(down % alignment, 0);
+            EXPECT_EQ(up % alignment, 0);
+        }
+    }
+}
+
+#if defined(__unix__)
+TEST(Alignment, SystemPageSize)
+{
+    const auto page{mu::page_size()};
+    EXPECT_GE(page, 4_kiB);
+    EXPECT_TRUE(mu::is_aligned(mu::huge_pages(1), page));
+    EXPECT_EQ(mu::align_up(1_B, page), page);
+}
+#endif
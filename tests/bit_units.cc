@@ -0,0 +1,77 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <type_traits>
+#include "memory_units.hpp"
+
+using namespace mu::literals;
+
+TEST(BitUnits, Factors)
+{
+    EXPECT_TRUE((std::is_same<mu::bits::factor, std::ratio<1, 8>>::value));
+    EXPECT_TRUE((std::is_same<mu::kilobits::factor, std::ratio<125>>::value));
+    EXPECT_TRUE((std::is_same<mu::megabits::factor, std::ratio<125000>>::value));
+    EXPECT_TRUE((std::is_same<mu::gigabits::factor, std::ratio<125000000>>::value));
+    EXPECT_TRUE((std::is_same<mu::kibibits::factor, std::ratio<128>>::value));
+    EXPECT_TRUE((std::is_same<mu::mebibits::factor, std::ratio<131072>>::value));
+}
+
+TEST(BitUnits, Literals)
+{
+    EXPECT_TRUE((std::is_same<decltype(8_b), mu::bits>::value));
+    EXPECT_TRUE((std::is_same<decltype(1_kb), mu::kilobits>::value));
+    EXPECT_TRUE((std::is_same<decltype(1_Mb), mu::megabits>::value));
+    EXPECT_TRUE((std::is_same<decltype(1_Gb), mu::gigabits>::value));
+    EXPECT_TRUE((std::is_same<decltype(1_kib), mu::kibibits>::value));
+    EXPECT_EQ((100_Mb).count(), 100u);
+    EXPECT_DOUBLE_EQ(static_cast<double>((2.5_Gb).count()), 2.5);
+}
+
+TEST(BitUnits, ConvertsToBytes)
+{
+    static_assert(8_b == 1_B, "A byte holds eight bits");
+    static_assert(mu::memory_size_cast<mu::bytes>(1_Gb) == 125_MB, "One gigabit is 125 megabytes");
+    EXPECT_EQ(mu::memory_size_cast<mu::bytes>(12_b), 1_B);
+    EXPECT_EQ(mu::ceil<mu::bytes>(12_b), 2_B);
+    EXPECT_EQ(mu::memory_size_cast<mu::mebibytes>(8_Mib), 1_MiB);
+    EXPECT_EQ(mu::memory_size_cast<mu::megabytes>(100_Mb).count(), 12u);
+    EXPECT_DOUBLE_EQ(mu::memory_size_cast<mu::f_megabytes>(100_Mb).count(), 12.5);
+}
+
+TEST(BitUnits, ConvertsFromBytes)
+{
+    const mu::bits from_bytes(3_kB);
+    EXPECT_EQ(from_bytes.count(), 24000u);
+    const mu::kibibits from_mebibytes(1_MiB);
+    EXPECT_EQ(from_mebibytes.count(), 8192u);
+    EXPECT_EQ(mu::memory_size_cast<mu::megabits>(1_GB).count(), 8000u);
+}
+
+TEST(BitUnits, MixedArithmeticAndComparisons)
+{
+    const auto total{1_B + 4_b};
+    EXPECT_EQ(total, 12_b);
+    EXPECT_TRUE((std::is_same<decltype(total), const mu::bits>::value));
+    EXPECT_LT(1_Gb, 1_GB);
+    EXPECT_GT(1_Gib, 1_Gb);
+    EXPECT_EQ(1_Mb / 1_kb, 1000u);
+    EXPECT_EQ(1_MB / 1_Mb, 8u);
+}
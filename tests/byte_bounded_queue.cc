@@ -0,0 +1,156 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "memory_units_queue.hpp"
+
+using namespace mu::literals;
+
+namespace
+{
+    struct string_size {
+        mu::bytes operator()(const std::string &message) const { return mu::bytes(message.size()); }
+    };
+
+    using message_queue = mu::byte_bounded_queue<std::string, string_size>;
+} // namespace
+
+TEST(ByteBoundedQueue, FifoOrder)
+{
+    message_queue queue(1_kiB);
+    EXPECT_TRUE(queue.empty());
+    EXPECT_TRUE(queue.try_push(std::string("first")));
+    EXPECT_TRUE(queue.try_push(std::string("second")));
+    EXPECT_EQ(queue.usage(), 11_B);
+
+    std::string message;
+    EXPECT_TRUE(queue.try_pop(message));
+    EXPECT_EQ(message, "first");
+    EXPECT_TRUE(queue.try_pop(message));
+    EXPECT_EQ(message, "second");
+    EXPECT_FALSE(queue.try_pop(message));
+    EXPECT_EQ(queue.usage(), 0_B);
+}
+
+TEST(ByteBoundedQueue, BoundedByBytes)
+{
+    message_queue queue(1_kiB);
+    EXPECT_TRUE(queue.try_push(std::string(600, 'a')));
+    std::string large(600, 'b');
+    EXPECT_FALSE(queue.try_push(std::move(large)));
+    EXPECT_EQ(large.size(), 600u); // Not moved from on failure
+    EXPECT_TRUE(queue.try_push(std::string(424, 'c')));
+    EXPECT_EQ(queue.usage(), 1_kiB);
+
+    std::string message;
+    queue.try_pop(message);
+    EXPECT_TRUE(queue.try_push(std::move(large)));
+}
+
+TEST(ByteBoundedQueue, OversizedElementOnlyEntersAnEmptyQueue)
+{
+    message_queue queue(1_kiB);
+    EXPECT_TRUE(queue.try_push(std::string(1, 'a')));
+    EXPECT_FALSE(queue.try_push(std::string(4096, 'b')));
+    std::string message;
+    queue.try_pop(message);
+    EXPECT_TRUE(queue.try_push(std::string(4096, 'b')));
+    EXPECT_EQ(queue.usage(), 4_kiB);
+}
+
+TEST(ByteBoundedQueue, BoundedByElements)
+{
+    mu::byte_bounded_queue<int> queue(1_MiB, 4);
+    EXPECT_EQ(queue.max_elements(), 4u);
+    for (int i{0}; i < 4; ++i)
+        EXPECT_TRUE(queue.try_push(i));
+    EXPECT_FALSE(queue.try_push(4));
+    EXPECT_EQ(queue.usage(), mu::bytes(4 * sizeof(int)));
+}
+
+TEST(ByteBoundedQueue, Batches)
+{
+    mu::byte_bounded_queue<std::uint64_t> queue(mu::bytes(100 * sizeof(std::uint64_t)), 256);
+    std::vector<std::uint64_t> values(150);
+    for (std::size_t i{0}; i < values.size(); ++i)
+        values[i] = i;
+    const auto pushed_until{queue.try_push_batch(values.begin(), values.end())};
+    EXPECT_EQ(pushed_until - values.begin(), 100);
+
+    std::vector<std::uint64_t> popped;
+    EXPECT_EQ(queue.try_pop_batch(std::back_inserter(popped), 70), 70u);
+    EXPECT_EQ(queue.try_pop_batch(std::back_inserter(popped), 70), 30u);
+    ASSERT_EQ(popped.size(), 100u);
+    for (std::size_t i{0}; i < popped.size(); ++i)
+        EXPECT_EQ(popped[i], i);
+    EXPECT_EQ(queue.usage(), 0_B);
+}
+
+TEST(ByteBoundedQueue, BlockingPushAndPop)
+{
+    message_queue queue(mu::bytes(10));
+    std::thread producer([&queue]() {
+        for (int i{0}; i < 1000; ++i)
+            queue.push(std::string(static_cast<std::size_t>(i % 10 + 1), 'x'));
+    });
+    std::size_t received{0};
+    for (int i{0}; i < 1000; ++i) {
+        const auto message{queue.pop()};
+        received += message.size();
+        EXPECT_LE(queue.usage(), mu::bytes(10));
+    }
+    producer.join();
+    EXPECT_EQ(received, 5500u);
+}
+
+TEST(ByteBoundedQueue, ManyProducersManyConsumers)
+{
+    mu::byte_bounded_queue<std::uint64_t> queue(256_B, 16);
+    constexpr std::uint64_t per_producer{20000};
+    std::atomic<std::uint64_t> sum{0};
+    std::vector<std::thread> threads;
+    for (std::uint64_t p{0}; p < 3; ++p)
+        threads.emplace_back([&queue, p]() {
+            std::vector<std::uint64_t> batch;
+            for (std::uint64_t i{1}; i <= per_producer; ++i) {
+                if (i % 2)
+                    queue.push(p * per_producer + i);
+                else {
+                    batch.assign(1, p * per_producer + i);
+                    while (queue.try_push_batch(batch.begin(), batch.end()) == batch.begin())
+                        std::this_thread::yield();
+                }
+            }
+        });
+    for (int c{0}; c < 3; ++c)
+        threads.emplace_back([&queue, &sum]() {
+            for (std::uint64_t i{0}; i < per_producer; ++i)
+                sum += queue.pop();
+        });
+    for (auto &thread : threads)
+        thread.join();
+    const auto total{3 * per_producer};
+    EXPECT_EQ(sum.load(), total * (total + 1) / 2);
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.usage(), 0_B);
+}
@@ -0,0 +1,115 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "memory_units_rate_limiter.hpp"
+
+using namespace mu::literals;
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    double seconds_since(const clock_type::time_point start)
+    {
+        return std::chrono::duration<double>(clock_type::now() - start).count();
+    }
+} // namespace
+
+TEST(ByteRateLimiter, GrantsTheBurstThenTheRate)
+{
+    mu::byte_rate_limiter limiter(mu::mebibytes_per_second(1), 64_kiB, 0_B);
+    EXPECT_EQ(limiter.burst(), 64_kiB);
+    EXPECT_EQ(limiter.credit_batch(), 0_B);
+    EXPECT_NEAR(limiter.rate().count(), 1048576.0, 1e-6);
+    EXPECT_TRUE(limiter.try_acquire(64_kiB));
+    EXPECT_FALSE(limiter.try_acquire(4_kiB));
+    EXPECT_LT(limiter.available(), 4_kiB);
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    EXPECT_GE(limiter.available(), 16_kiB);
+    EXPECT_TRUE(limiter.try_acquire(16_kiB));
+}
+
+TEST(ByteRateLimiter, GrantsOversizedRequestsOnlyToAFullBucket)
+{
+    mu::byte_rate_limiter limiter(mu::mebibytes_per_second(1), 4_kiB, 0_B);
+    EXPECT_TRUE(limiter.try_acquire(256_kiB));
+    EXPECT_FALSE(limiter.try_acquire(1_B));
+    EXPECT_FALSE(limiter.try_acquire(256_kiB));
+    EXPECT_EQ(limiter.available(), 0_B);
+}
+
+TEST(ByteRateLimiter, AcquireWaitsForTheRate)
+{
+    mu::byte_rate_limiter limiter(mu::mebibytes_per_second(1), 1_kiB, 0_B);
+    const auto start{clock_type::now()};
+    limiter.acquire(1_kiB);
+    EXPECT_LT(seconds_since(start), 0.05);
+    limiter.acquire(100_kiB);
+    limiter.acquire(1_kiB);
+    const auto elapsed{seconds_since(start)};
+    EXPECT_GE(elapsed, 0.09);
+    EXPECT_LT(elapsed, 1.0);
+}
+
+TEST(ByteRateLimiter, CachesCreditsForTinyRequests)
+{
+    mu::byte_rate_limiter limiter(mu::kibibytes_per_second(1), 64_kiB, 4_kiB);
+    std::uint64_t granted{0};
+    for (int i{0}; i < 10000; ++i)
+        if (limiter.try_acquire(16_B))
+            granted += 16;
+    EXPECT_GE(granted, 60u * 1024);
+    EXPECT_LE(granted, 68u * 1024);
+    EXPECT_FALSE(limiter.try_acquire(16_kiB));
+}
+
+TEST(ByteRateLimiter, HoldsTheRateAcrossThreads)
+{
+    mu::byte_rate_limiter limiter(mu::mebibytes_per_second(8), 64_kiB);
+    std::atomic<std::uint64_t> granted{0};
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> threads;
+    const auto start{clock_type::now()};
+    for (int t{0}; t < 4; ++t)
+        threads.emplace_back([&]() {
+            std::uint64_t local{0};
+            while (!stop.load(std::memory_order_relaxed))
+                if (limiter.try_acquire(64_B))
+                    local += 64;
+            granted += local;
+        });
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    stop = true;
+    for (auto &thread : threads)
+        thread.join();
+    const auto expected{64.0 * 1024 + 8.0 * 1024 * 1024 * seconds_since(start)};
+    EXPECT_GT(static_cast<double>(granted.load()), 0.8 * expected);
+    EXPECT_LT(static_cast<double>(granted.load()), 1.1 * expected + 4 * limiter.credit_batch().count());
+}
+
+TEST(ByteRateLimiter, RejectsNullRates)
+{
+    EXPECT_THROW(mu::byte_rate_limiter(mu::bytes_per_second(0), 1_kiB), std::invalid_argument);
+}
@@ -0,0 +1,181 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#if defined(__linux__)
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <sys/stat.h>
+#include <time.h>
+#include "memory_units_cgroup.hpp"
+
+using namespace mu::literals;
+
+namespace
+{
+    class FakeCgroupTree : public ::testing::Test {
+    protected:
+        void SetUp() override
+        {
+            char pattern[] = "/tmp/mu_cgroup_XXXXXX";
+            ASSERT_NE(::mkdtemp(pattern), nullptr);
+            root = pattern;
+            make_directory("/fs");
+            make_directory("/fs/service.slice");
+            make_directory("/fs/service.slice/worker");
+            write("/fs/memory.pressure", "");
+            write("/fs/service.slice/memory.max", "8589934592\n");
+            write("/fs/service.slice/memory.high", "max\n");
+            write("/fs/service.slice/worker/memory.max", "max\n");
+            write("/fs/service.slice/worker/memory.high", "6442450944\n");
+            write("/fs/service.slice/worker/memory.current", "1073741824\n");
+            write("/fs/service.slice/worker/memory.pressure",
+                  "some avg10=1.50 avg60=0.75 avg300=0.20 total=123456\n"
+                  "full avg10=0.50 avg60=0.25 avg300=0.10 total=6543\n");
+            write("/cgroup", "4:memory:/legacy\n0::/service.slice/worker\n");
+        }
+
+        void TearDown() override
+        {
+            for (auto it{created.rbegin()}; it != created.rend(); ++it)
+                std::remove(it->c_str());
+        }
+
+        void make_directory(const std::string &path)
+        {
+            ASSERT_EQ(::mkdir((root + path).c_str(), 0700), 0);
+            created.push_back(root + path);
+        }
+
+        void write(const std::string &path, const std::string &content)
+        {
+            auto file{std::fopen((root + path).c_str(), "w")};
+            ASSERT_NE(file, nullptr);
+            std::fputs(content.c_str(), file);
+            std::fclose(file);
+            created.push_back(root + path);
+        }
+
+        std::string read(const std::string &path) const
+        {
+            std::string content(256, '\0');
+            auto file{std::fopen((root + path).c_str(), "r")};
+            content.resize(std::fread(&content[0], 1, content.size(), file));
+            std::fclose(file);
+            return content;
+        }
+
+        std::string root;
+        std::vector<std::string> created;
+    };
+} // namespace
+
+TEST_F(FakeCgroupTree, CurrentPath)
+{
+    EXPECT_EQ(mu::cgroup::current_path(root + "/cgroup"), "/service.slice/worker");
+    EXPECT_EQ(mu::cgroup::current_directory(root + "/fs", root + "/cgroup"), root + "/fs/service.slice/worker");
+}
+
+TEST_F(FakeCgroupTree, EffectiveLimits)
+{
+    const auto limits{mu::cgroup::limits(root + "/fs", root + "/cgroup")};
+    EXPECT_EQ(limits.max, 8_GiB);
+    EXPECT_EQ(limits.high, 6_GiB);
+    EXPECT_EQ(limits.current, 1_GiB);
+    EXPECT_EQ(limits.headroom(), 5_GiB);
+}
+
+TEST_F(FakeCgroupTree, UnlimitedRootCgroup)
+{
+    write("/root_cgroup", "0::/\n");
+    const auto limits{mu::cgroup::limits(root + "/fs", root + "/root_cgroup")};
+    EXPECT_EQ(limits.max, mu::bytes::max());
+    EXPECT_EQ(limits.high, mu::bytes::max());
+    EXPECT_EQ(limits.current, 0_B);
+}
+
+TEST_F(FakeCgroupTree, MissingHierarchy)
+{
+    write("/v1_only", "4:memory:/legacy\n");
+    EXPECT_THROW(mu::cgroup::limits(root + "/fs", root + "/v1_only"), std::runtime_error);
+    EXPECT_THROW(mu::cgroup::limits(root + "/fs", root + "/missing"), std::system_error);
+}
+
+TEST_F(FakeCgroupTree, ReadPressure)
+{
+    const auto pressure{mu::cgroup::read_pressure(root + "/fs/service.slice/worker")};
+    EXPECT_DOUBLE_EQ(pressure.some.avg10, 1.5);
+    EXPECT_DOUBLE_EQ(pressure.some.avg60, 0.75);
+    EXPECT_DOUBLE_EQ(pressure.some.avg300, 0.2);
+    EXPECT_EQ(pressure.some.total.count(), 123456);
+    EXPECT_DOUBLE_EQ(pressure.full.avg10, 0.5);
+    EXPECT_EQ(pressure.full.total.count(), 6543);
+}
+
+TEST_F(FakeCgroupTree, PressureWatcherRegistersTriggers)
+{
+    std::atomic<int> notifications{0};
+    mu::cgroup::pressure_watcher watcher(root + "/fs");
+    watcher.subscribe(mu::cgroup::stall::some, std::chrono::milliseconds(150), std::chrono::seconds(1),
+                      [&notifications](mu::cgroup::stall) { ++notifications; });
+    EXPECT_EQ(read("/fs/memory.pressure"), std::string("some 150000 1000000\0", 20));
+
+    watcher.start();
+    EXPECT_THROW(watcher.subscribe(mu::cgroup::stall::full, std::chrono::milliseconds(100), std::chrono::seconds(1),
+                                   [](mu::cgroup::stall) {}),
+                 std::logic_error);
+    watcher.stop();
+    // Regular files never raise POLLPRI: only the kernel can fire the trigger.
+    EXPECT_EQ(notifications.load(), 0);
+}
+
+TEST_F(FakeCgroupTree, PressureWatcherSleepsAfterARestart)
+{
+    mu::cgroup::pressure_watcher watcher(root + "/fs");
+    watcher.subscribe(mu::cgroup::stall::some, std::chrono::milliseconds(150), std::chrono::seconds(1),
+                      [](mu::cgroup::stall) {});
+    watcher.start();
+    watcher.stop();
+    watcher.start();
+    const auto cpu_time = []() {
+        timespec now{};
+        ::clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+        return std::chrono::seconds(now.tv_sec) + std::chrono::nanoseconds(now.tv_nsec);
+    };
+    const auto before{cpu_time()};
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    const auto spent{cpu_time() - before};
+    watcher.stop();
+    // A watcher woken up by a stale stop event would spin for the whole 200 ms.
+    EXPECT_LT(spent, std::chrono::milliseconds(50));
+}
+
+TEST_F(FakeCgroupTree, PressureWatcherMissingInterface)
+{
+    mu::cgroup::pressure_watcher watcher(root + "/fs/service.slice");
+    EXPECT_THROW(watcher.subscribe(mu::cgroup::stall::full, std::chrono::milliseconds(100), std::chrono::seconds(1),
+                                   [](mu::cgroup::stall) {}),
+                 std::system_error);
+}
+#endif
@@ -0,0 +1,35 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+// Compiled as C++11 on its own: the core header, exact literals included, must not need a later standard.
+#include "memory_units.hpp"
+
+namespace
+{
+    using namespace mu::literals::exact;
+    static_assert((1.5_GiB).count() == 1610612736, "1.5 GiB");
+    static_assert((25E-1_kB).count() == 2500, "2.5 kB");
+    static_assert((1.00000000000000000000000_GB).count() == 1000000000, "Trailing zeros are cancelled");
+    static_assert((95367431640625e-20_EiB).count() == 1099511627776, "1 TiB");
+    static_assert((0.5_kb).count() == 500, "Fractional bit literals give bits");
+    static_assert((0x10_kB).count() == 16, "Integer literals keep their unit");
+    static_assert(mu::floor<mu::mebibytes>(1536_kiB).count() == 1, "Rounded down");
+    static_assert(mu::round<mu::kilobytes>(2500_B).count() == 2, "Halfway rounded to even");
+    static_assert(mu::ceil<mu::bytes>(mu::f_bytes(2.25)).count() == 3, "Floating sizes rounded up");
+} // namespace
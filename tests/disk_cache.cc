@@ -0,0 +1,245 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#if defined(__unix__)
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <dirent.h>
+#include <ftw.h>
+#include <gtest/gtest.h>
+#include "memory_units_disk_cache.hpp"
+
+using namespace mu::literals;
+
+namespace
+{
+    class DiskCache : public ::testing::Test {
+    protected:
+        void SetUp() override
+        {
+            char pattern[] = "/tmp/mu_disk_cache_XXXXXX";
+            ASSERT_NE(::mkdtemp(pattern), nullptr);
+            directory = pattern;
+        }
+
+        void TearDown() override
+        {
+            ::nftw(directory.c_str(),
+                   [](const char *path, const struct stat *, int, struct FTW *) { return std::remove(path); }, 16,
+                   FTW_DEPTH | FTW_PHYS);
+        }
+
+        std::string directory;
+    };
+
+    // Paths of the files of the objects directory of a cache, temporary files included.
+    std::vector<std::string> objects(const std::string &directory)
+    {
+        std::vector<std::string> paths;
+        auto *stream{::opendir((directory + "/objects").c_str())};
+        while (const auto *entry{::readdir(stream)}) {
+            const std::string name{entry->d_name};
+            if (name != "." && name != "..")
+                paths.push_back(directory + "/objects/" + name);
+        }
+        ::closedir(stream);
+        return paths;
+    }
+
+    // Charge of an entry: its whole blob, header and key included.
+    mu::bytes charge(const std::string &key, const std::size_t size)
+    {
+        return mu::bytes(sizeof(mu::details::disk_cache_blob_header) + key.size() + size);
+    }
+} // namespace
+
+TEST_F(DiskCache, PutAndGet)
+{
+    mu::disk_cache cache(directory, 1_MiB);
+    EXPECT_TRUE(cache.put("alpha", std::string(1000, 'a')));
+    EXPECT_TRUE(cache.put("beta", std::string(3000, 'b')));
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_EQ(cache.usage(), charge("alpha", 1000) + charge("beta", 3000));
+
+    std::string content;
+    EXPECT_TRUE(cache.get("alpha", content));
+    EXPECT_EQ(content, std::string(1000, 'a'));
+    EXPECT_FALSE(cache.get("gamma", content));
+
+    EXPECT_TRUE(cache.put("alpha", std::string(10, 'c')));
+    EXPECT_EQ(cache.usage(), charge("alpha", 10) + charge("beta", 3000));
+    EXPECT_TRUE(cache.get("alpha", content));
+    EXPECT_EQ(content, std::string(10, 'c'));
+
+    EXPECT_TRUE(cache.erase("beta"));
+    EXPECT_FALSE(cache.erase("beta"));
+    EXPECT_FALSE(cache.contains("beta"));
+    EXPECT_EQ(cache.usage(), charge("alpha", 10));
+}
+
+TEST_F(DiskCache, EvictsLeastRecentlyUsedWhenOverCapacity)
+{
+    const auto capacity{10 * charge("key0", 1024)};
+    mu::disk_cache cache(directory, capacity);
+    for (int i{0}; i < 10; ++i)
+        EXPECT_TRUE(cache.put("key" + std::to_string(i), std::string(1024, 'x')));
+    EXPECT_EQ(cache.usage(), capacity);
+    std::string content;
+    EXPECT_TRUE(cache.get("key0", content));
+    EXPECT_TRUE(cache.put("key10", std::string(2048, 'y')));
+
+    EXPECT_LE(cache.usage(), capacity);
+    EXPECT_TRUE(cache.contains("key0"));
+    EXPECT_TRUE(cache.contains("key10"));
+    EXPECT_FALSE(cache.contains("key1"));
+    EXPECT_FALSE(cache.contains("key2"));
+    EXPECT_FALSE(cache.put("huge", std::string(11 * 1024, 'z')));
+}
+
+TEST_F(DiskCache, ReopensFromTheIndex)
+{
+    auto usage{0_B};
+    for (int i{0}; i < 100; ++i)
+        usage += i == 50 ? 0_B : charge("key" + std::to_string(i), static_cast<std::size_t>(i));
+    {
+        mu::disk_cache cache(directory, 1_MiB, 1000);
+        for (int i{0}; i < 100; ++i)
+            cache.put("key" + std::to_string(i), std::string(static_cast<std::size_t>(i), 'x'));
+        cache.erase("key50");
+    }
+    mu::disk_cache cache(directory, 1_MiB);
+    EXPECT_EQ(cache.size(), 99u);
+    EXPECT_EQ(cache.usage(), usage);
+    EXPECT_EQ(objects(directory).size(), 99u);
+    EXPECT_EQ(cache.max_entries(), 1536u);
+    EXPECT_EQ(cache.index_size(), mu::bytes(64 + 2048 * 32));
+    std::string content;
+    EXPECT_TRUE(cache.get("key99", content));
+    EXPECT_EQ(content.size(), 99u);
+    EXPECT_FALSE(cache.contains("key50"));
+}
+
+TEST_F(DiskCache, IndexFullEvictsEntries)
+{
+    mu::disk_cache cache(directory, 1_MiB, 12);
+    for (int i{0}; i < 100; ++i)
+        EXPECT_TRUE(cache.put("key" + std::to_string(i), "value"));
+    EXPECT_LE(cache.size(), 12u);
+    EXPECT_TRUE(cache.contains("key99"));
+    auto usage{0_B};
+    for (int i{0}; i < 100; ++i)
+        if (cache.contains("key" + std::to_string(i)))
+            usage += charge("key" + std::to_string(i), 5);
+    EXPECT_EQ(cache.usage(), usage);
+}
+
+TEST_F(DiskCache, MissingBlobIsForgotten)
+{
+    mu::disk_cache cache(directory, 1_MiB);
+    cache.put("alpha", "content");
+    ::nftw((directory + "/objects").c_str(),
+           [](const char *path, const struct stat *, const int type, struct FTW *) {
+               return type == FTW_F ? std::remove(path) : 0;
+           },
+           16, FTW_PHYS);
+    std::string content;
+    EXPECT_FALSE(cache.get("alpha", content));
+    EXPECT_FALSE(cache.contains("alpha"));
+    EXPECT_EQ(cache.usage(), 0_B);
+}
+
+TEST_F(DiskCache, ConcurrentPutsOfOneKey)
+{
+    mu::disk_cache cache(directory, 1_MiB);
+    std::vector<std::thread> writers;
+    for (char fill{'a'}; fill < 'i'; ++fill) {
+        writers.emplace_back([&cache, fill] {
+            for (int i{0}; i < 50; ++i)
+                cache.put("shared", std::string(static_cast<std::size_t>(4000 + fill), fill));
+        });
+    }
+    for (auto &writer : writers)
+        writer.join();
+
+    std::string content;
+    ASSERT_TRUE(cache.get("shared", content));
+    EXPECT_EQ(content, std::string(static_cast<std::size_t>(4000 + content.front()), content.front()));
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT_EQ(cache.usage(), charge("shared", content.size()));
+    EXPECT_EQ(objects(directory).size(), 1u); // No temporary file left behind
+}
+
+TEST_F(DiskCache, BlobOfAnotherKeyIsNotReturned)
+{
+    char pattern[] = "/tmp/mu_disk_cache_XXXXXX";
+    ASSERT_NE(::mkdtemp(pattern), nullptr);
+    const std::string other_directory{pattern};
+    {
+        mu::disk_cache other(other_directory, 1_MiB);
+        other.put("beta", std::string(100, 'b'));
+    }
+    mu::disk_cache cache(directory, 1_MiB);
+    cache.put("alpha", std::string(100, 'a'));
+
+    // Same generation, as if both keys had the same hash
+    {
+        std::ifstream source(objects(other_directory).front(), std::ios::binary);
+        std::ofstream destination(objects(directory).front(), std::ios::binary | std::ios::trunc);
+        destination << source.rdbuf();
+    }
+    std::string content;
+    EXPECT_FALSE(cache.get("alpha", content));
+    ::nftw(other_directory.c_str(),
+           [](const char *path, const struct stat *, int, struct FTW *) { return std::remove(path); }, 16,
+           FTW_DEPTH | FTW_PHYS);
+}
+
+TEST_F(DiskCache, RemovesOrphansOnOpen)
+{
+    {
+        mu::disk_cache cache(directory, 1_MiB);
+        cache.put("alpha", "content");
+    }
+    // Left behind by crashes before and after the publication of a blob
+    for (const auto name : {"/objects/.tmp-a1b2c3", "/objects/0123456789abcdef"}) {
+        auto file{std::fopen((directory + name).c_str(), "w")};
+        std::fputs("orphan", file);
+        std::fclose(file);
+    }
+    ASSERT_EQ(objects(directory).size(), 3u);
+    mu::disk_cache cache(directory, 1_MiB);
+    EXPECT_EQ(objects(directory).size(), 1u);
+    std::string content;
+    EXPECT_TRUE(cache.get("alpha", content));
+    EXPECT_EQ(content, "content");
+    EXPECT_EQ(cache.usage(), charge("alpha", 7));
+}
+
+TEST_F(DiskCache, CorruptedIndex)
+{
+    auto file{std::fopen((directory + "/index").c_str(), "w")};
+    std::fputs("definitely not an index", file);
+    std::fclose(file);
+    EXPECT_THROW(mu::disk_cache(directory, 1_MiB), std::runtime_error);
+}
+#endif
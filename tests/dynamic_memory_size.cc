@@ -0,0 +1,175 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <limits>
+#include <vector>
+#include "memory_units_dynamic.hpp"
+
+using namespace mu::literals;
+
+TEST(DynamicMemorySize, FitsInSixteenBytes) { EXPECT_LE(sizeof(mu::dynamic_memory_size), 16u); }
+
+TEST(DynamicMemorySize, ConstructsFromStaticSizes)
+{
+    const mu::dynamic_memory_size size{3_MiB};
+    EXPECT_EQ(size.count(), 3u);
+    EXPECT_EQ(size.unit(), mu::memory_unit::mib);
+    EXPECT_EQ(mu::dynamic_memory_size(mu::pages(2)).unit(), mu::memory_unit::page);
+    EXPECT_EQ(mu::dynamic_memory_size(mu::megabits(5)).unit(), mu::memory_unit::mbit);
+}
+
+TEST(DynamicMemorySize, ConvertsToStaticSizes)
+{
+    const mu::dynamic_memory_size size{3, mu::memory_unit::mib};
+    EXPECT_EQ(size.as<mu::kibibytes>(), 3072_kiB);
+    EXPECT_EQ(mu::memory_size_cast<mu::bytes>(size), 3145728_B);
+    EXPECT_EQ(static_cast<mu::megabytes>(size), 3_MB);
+    EXPECT_EQ(size.as<mu::bits>(), mu::bits(25165824));
+    EXPECT_EQ(mu::dynamic_memory_size(12, mu::memory_unit::bit).to_bytes(), 1_B);
+    EXPECT_EQ(mu::dynamic_memory_size(1, mu::memory_unit::huge_page).as<mu::pages>(), mu::pages(512));
+    constexpr auto folded{mu::dynamic_memory_size(2, mu::memory_unit::gb).as<mu::megabytes>()};
+    static_assert(folded.count() == 2000, "Conversions can be evaluated at compile time");
+}
+
+TEST(DynamicMemorySize, ConvertsToFloatingPointSizes)
+{
+    const mu::dynamic_memory_size size{512, mu::memory_unit::mib};
+    EXPECT_DOUBLE_EQ(static_cast<mu::f_gibibytes>(size).count(), 0.5);
+    EXPECT_DOUBLE_EQ(size.as<mu::f_gibibytes>().count(),
+                     mu::memory_size_cast<mu::f_gibibytes>(mu::mebibytes(512)).count());
+    EXPECT_DOUBLE_EQ(mu::dynamic_memory_size(1, mu::memory_unit::kib).as<mu::f_kilobytes>().count(), 1.024);
+    EXPECT_DOUBLE_EQ(mu::dynamic_memory_size(12, mu::memory_unit::bit).as<mu::f_bytes>().count(), 1.5);
+}
+
+TEST(DynamicMemorySize, ConvertsLargeCountsWithoutOverflow)
+{
+    // 2^40 EB is 2^40 * 5^18 / 2^42 EiB, the product overflows 64 bits but not the result
+    EXPECT_EQ(mu::dynamic_memory_size(std::uint64_t{1} << 40, mu::memory_unit::eb).as<mu::exbibytes>(),
+              mu::exbibytes(953674316406));
+    EXPECT_EQ(mu::dynamic_memory_size(std::uint64_t{1} << 60, mu::memory_unit::bit).as<mu::bytes>(),
+              mu::bytes(std::uint64_t{1} << 57));
+    const auto largest{std::numeric_limits<std::uint64_t>::max()};
+    EXPECT_EQ(mu::dynamic_memory_size(largest, mu::memory_unit::kb).as<mu::kibibytes>(),
+              mu::kibibytes(18014398509481983999ULL));
+    EXPECT_THROW(static_cast<void>(mu::dynamic_memory_size(largest, mu::memory_unit::gib).as<mu::bytes>()),
+                 std::overflow_error);
+    EXPECT_THROW(static_cast<void>(mu::dynamic_memory_size(largest / 1000, mu::memory_unit::mb).to_bytes()),
+                 std::overflow_error);
+}
+
+TEST(DynamicMemorySize, ConvertsBetweenUnits)
+{
+    const mu::dynamic_memory_size size{2, mu::memory_unit::gib};
+    const auto converted{size.in(mu::memory_unit::mib)};
+    EXPECT_EQ(converted.count(), 2048u);
+    EXPECT_EQ(converted.unit(), mu::memory_unit::mib);
+    EXPECT_EQ(mu::dynamic_memory_size(1500, mu::memory_unit::kb).in(mu::memory_unit::mb).count(), 1u);
+    EXPECT_EQ(mu::dynamic_memory_size(3, mu::memory_unit::b).in(mu::memory_unit::bit).count(), 24u);
+}
+
+TEST(DynamicMemorySize, ConvertsBetweenUnitsAtTheLimit)
+{
+    const auto largest{std::numeric_limits<std::uint64_t>::max()};
+    EXPECT_EQ(mu::dynamic_memory_size(largest / 1024, mu::memory_unit::kib).in(mu::memory_unit::b).count(),
+              18446744073709550592ULL);
+    EXPECT_EQ(mu::dynamic_memory_size(largest, mu::memory_unit::kb).in(mu::memory_unit::kib).count(),
+              18014398509481983999ULL);
+    EXPECT_EQ(mu::dynamic_memory_size(largest, mu::memory_unit::bit).in(mu::memory_unit::b).count(), largest / 8);
+    EXPECT_THROW(static_cast<void>(mu::dynamic_memory_size(largest / 1024 + 1, mu::memory_unit::kib)
+                                           .in(mu::memory_unit::b)),
+                 std::overflow_error);
+    EXPECT_THROW(static_cast<void>(mu::dynamic_memory_size(largest, mu::memory_unit::kib).in(mu::memory_unit::kb)),
+                 std::overflow_error);
+}
+
+TEST(DynamicMemorySize, ArithmeticThrowsWhenTheCommonUnitOverflows)
+{
+    const auto largest{std::numeric_limits<std::uint64_t>::max()};
+    const mu::dynamic_memory_size huge{largest, mu::memory_unit::kib};
+    const mu::dynamic_memory_size small{1, mu::memory_unit::b};
+    EXPECT_THROW(static_cast<void>(huge == small), std::overflow_error);
+    EXPECT_THROW(static_cast<void>(small < huge), std::overflow_error);
+    EXPECT_THROW(static_cast<void>(huge + small), std::overflow_error);
+    const auto sum{mu::dynamic_memory_size(largest / 8, mu::memory_unit::b) +
+                   mu::dynamic_memory_size(7, mu::memory_unit::bit)};
+    EXPECT_EQ(sum.count(), largest);
+}
+
+TEST(DynamicMemorySize, ThrowsOnNegativeCountsAndOverflowingArithmetic)
+{
+    EXPECT_THROW(static_cast<void>(mu::dynamic_memory_size(mu::memory_size<std::int64_t, mu::kibibytes::factor>(-1))),
+                 std::overflow_error);
+    EXPECT_EQ(mu::dynamic_memory_size(mu::memory_size<std::int64_t, mu::kibibytes::factor>(0)).count(), 0u);
+
+    const auto largest{std::numeric_limits<std::uint64_t>::max()};
+    const mu::dynamic_memory_size most{largest, mu::memory_unit::b};
+    const mu::dynamic_memory_size one{1, mu::memory_unit::b};
+    EXPECT_THROW(static_cast<void>(most + one), std::overflow_error);
+    EXPECT_THROW(static_cast<void>(one - mu::dynamic_memory_size(2, mu::memory_unit::b)), std::overflow_error);
+    EXPECT_THROW(static_cast<void>(most * 2), std::overflow_error);
+    EXPECT_EQ((one - one).count(), 0u);
+
+    auto accumulated{most};
+    EXPECT_THROW(accumulated += one, std::overflow_error);
+    EXPECT_THROW(accumulated *= 2, std::overflow_error);
+    EXPECT_EQ(accumulated.count(), largest);
+}
+
+TEST(DynamicMemorySize, ArithmeticUsesTheCommonUnit)
+{
+    const auto sum{mu::dynamic_memory_size(1_GiB) + mu::dynamic_memory_size(512_MiB)};
+    EXPECT_EQ(sum.unit(), mu::memory_unit::mib);
+    EXPECT_EQ(sum.count(), 1536u);
+
+    const auto mixed{mu::dynamic_memory_size(1_kB) + mu::dynamic_memory_size(1_kiB)};
+    EXPECT_EQ(mixed.unit(), mu::memory_unit::b);
+    EXPECT_EQ(mixed.count(), 2024u);
+
+    const auto with_bits{mu::dynamic_memory_size(1_B) - mu::dynamic_memory_size(mu::bits(3))};
+    EXPECT_EQ(with_bits.unit(), mu::memory_unit::bit);
+    EXPECT_EQ(with_bits.count(), 5u);
+
+    EXPECT_EQ((mu::dynamic_memory_size(3_MiB) * 2).count(), 6u);
+    EXPECT_EQ(mu::dynamic_memory_size(1_GiB) / mu::dynamic_memory_size(mu::pages(1)), 262144u);
+
+    std::vector<mu::dynamic_memory_size> sizes{mu::dynamic_memory_size(1_MiB), mu::dynamic_memory_size(1_MB),
+                                               mu::dynamic_memory_size(mu::pages(4))};
+    mu::dynamic_memory_size total{};
+    for (const auto &size : sizes)
+        total += size;
+    EXPECT_EQ(total.to_bytes(), 1_MiB + 1_MB + 16_kiB);
+}
+
+TEST(DynamicMemorySize, ComparesAcrossUnits)
+{
+    EXPECT_EQ(mu::dynamic_memory_size(1_MiB), mu::dynamic_memory_size(1024_kiB));
+    EXPECT_LT(mu::dynamic_memory_size(1_MB), mu::dynamic_memory_size(1_MiB));
+    EXPECT_GT(mu::dynamic_memory_size(mu::megabits(9)), mu::dynamic_memory_size(1_MB));
+    EXPECT_NE(mu::dynamic_memory_size(1_kB), mu::dynamic_memory_size(1_kiB));
+}
+
+TEST(DynamicMemorySize, ParsesUnitSymbols)
+{
+    for (const auto unit : {mu::memory_unit::b, mu::memory_unit::mib, mu::memory_unit::gbit, mu::memory_unit::page})
+        EXPECT_EQ(mu::parse_memory_unit(mu::symbol(unit)), unit);
+    EXPECT_STREQ(mu::symbol(mu::memory_unit::kib), "kiB");
+    EXPECT_THROW(mu::parse_memory_unit("MiBs"), std::invalid_argument);
+}
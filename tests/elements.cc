@@ -0,0 +1,72 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "memory_units.hpp"
+
+using namespace mu::literals;
+
+namespace
+{
+    struct sample {
+        double value;
+        std::uint32_t id;
+    };
+} // namespace
+
+TEST(Elements, FactorIsTheSizeOfTheType)
+{
+    static_assert(mu::memory_size_cast<mu::elements<float>>(64_MiB) == mu::elements<float>(16777216), "");
+    static_assert(mu::elements<double>(3) == 24_B, "");
+    static_assert(std::is_same<mu::elements<char>, mu::bytes>::value, "");
+    static_assert(std::is_same<mu::elements<sample>::factor, std::ratio<sizeof(sample)>>::value, "");
+    EXPECT_EQ(mu::memory_size_cast<mu::bytes>(mu::elements<sample>(10)), mu::bytes(10 * sizeof(sample)));
+    EXPECT_EQ(mu::memory_size_cast<mu::elements<sample>>(1_kiB).count(), 1024 / sizeof(sample));
+    EXPECT_DOUBLE_EQ((mu::memory_size_cast<mu::elements<std::uint64_t, double>>(mu::bytes(12)).count()), 1.5);
+}
+
+TEST(Elements, ConvertsImplicitlyWhenExact)
+{
+    const mu::bytes size{mu::elements<std::uint32_t>(5)};
+    EXPECT_EQ(size, 20_B);
+    EXPECT_EQ(mu::elements<std::uint64_t>(1) + mu::elements<std::uint32_t>(1), mu::elements<std::uint32_t>(3));
+}
+
+TEST(Elements, ReservesContainersFromABudget)
+{
+    std::vector<float> values;
+    const auto reserved{mu::reserve_for(values, 1_MiB)};
+    EXPECT_EQ(reserved.count(), 262144u);
+    EXPECT_GE(values.capacity(), 262144u);
+    EXPECT_TRUE(values.empty());
+
+    std::deque<sample> samples;
+    EXPECT_EQ(mu::resize_for(samples, mu::f_kibibytes(1.5)).count(), 1536 / sizeof(sample));
+    EXPECT_EQ(samples.size(), 1536 / sizeof(sample));
+
+    std::string text;
+    EXPECT_EQ(mu::resize_for(text, 2_kB).count(), 2000u);
+    EXPECT_EQ(text.size(), 2000u);
+}
@@ -0,0 +1,99 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <type_traits>
+#include "memory_units.hpp"
+
+// The exact literals replace the default ones, using both namespaces in one scope makes every literal ambiguous.
+namespace default_literals
+{
+    using namespace mu::literals;
+    constexpr auto bytes{2_B};
+    constexpr auto gigabytes{2_GB};
+    constexpr auto gibibytes{2_GiB};
+    constexpr auto tebibits{2_Tib};
+    constexpr auto kilobits{2_kb};
+} // namespace default_literals
+
+using namespace mu::literals::exact;
+
+TEST(ExactLiterals, FractionsGiveWholeBytes)
+{
+    constexpr auto size{1.5_GiB};
+    static_assert(std::is_same<decltype(size), const mu::bytes>::value, "Fractional literals give bytes");
+    static_assert(size.count() == 1610612736, "1.5 GiB");
+    EXPECT_EQ(0.25_kiB, mu::bytes(256));
+    EXPECT_EQ(2.5_MB, mu::bytes(2500000));
+    EXPECT_EQ(0.001_kB, mu::bytes(1));
+    EXPECT_EQ(1.75_EiB, mu::bytes(2017612633061982208));
+    EXPECT_EQ(12.0_B, mu::bytes(12));
+    EXPECT_EQ(0.0_TB, mu::bytes(0));
+}
+
+TEST(ExactLiterals, IntegersMatchTheDefaultLiterals)
+{
+    static_assert(std::is_same<decltype(2_B), std::remove_const<decltype(default_literals::bytes)>::type>::value, "");
+    static_assert(std::is_same<decltype(2_GB), std::remove_const<decltype(default_literals::gigabytes)>::type>::value,
+                  "");
+    static_assert(std::is_same<decltype(2_GiB), std::remove_const<decltype(default_literals::gibibytes)>::type>::value,
+                  "");
+    static_assert(std::is_same<decltype(2_Tib), std::remove_const<decltype(default_literals::tebibits)>::type>::value,
+                  "");
+    static_assert(std::is_same<decltype(2_kb), std::remove_const<decltype(default_literals::kilobits)>::type>::value,
+                  "");
+    EXPECT_EQ(2_GiB, default_literals::gibibytes);
+    EXPECT_EQ(2_kb, default_literals::kilobits);
+}
+
+TEST(ExactLiterals, TrailingZerosAreCancelled)
+{
+    EXPECT_EQ(1.00000000000000000000000_GB, mu::bytes(1000000000));
+    EXPECT_EQ(2.50000000000000000000000000000_kiB, mu::bytes(2560));
+    EXPECT_EQ(100000000000000000000000e-20_kB, mu::bytes(1000000));
+    EXPECT_EQ(0.000000000000000000000000_EB, mu::bytes(0));
+    EXPECT_EQ(10.0_B, mu::bytes(10));
+}
+
+TEST(ExactLiterals, ExponentsAndSeparators)
+{
+    EXPECT_EQ(1e3_kB, mu::bytes(1000000));
+    EXPECT_EQ(25E-1_kB, mu::bytes(2500));
+    EXPECT_EQ(1'024.5_kiB, mu::bytes(1049088));
+    EXPECT_EQ(95367431640625e-20_EiB, mu::bytes(1099511627776));
+}
+
+TEST(ExactLiterals, BitUnitsGiveWholeBits)
+{
+    constexpr auto rate{1.5_Mb};
+    static_assert(std::is_same<decltype(rate), const mu::bits>::value, "Fractional bit literals give bits");
+    EXPECT_EQ(rate, mu::bits(1500000));
+    EXPECT_EQ(0.5_kib, mu::bits(512));
+    EXPECT_EQ(0.5_kb, mu::bytes(62) + mu::bits(4));
+}
+
+TEST(ExactLiterals, IntegersKeepTheirUnit)
+{
+    static_assert(std::is_same<decltype(3_GiB), mu::gibibytes>::value, "Integer literals keep their unit");
+    EXPECT_EQ(3_GiB, mu::gibibytes(3));
+    EXPECT_EQ(0x10_kB, mu::kilobytes(16));
+    EXPECT_EQ(010_MiB, mu::mebibytes(8));
+    EXPECT_EQ(1.5_GiB, mu::bytes(3_GiB) / 2);
+}
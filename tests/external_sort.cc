@@ -0,0 +1,120 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <vector>
+#include "memory_units_external_sort.hpp"
+
+using namespace mu::literals;
+
+#if defined(__unix__)
+
+namespace
+{
+    std::vector<std::uint64_t> random_values(const std::size_t count, const std::uint64_t seed)
+    {
+        std::mt19937_64 engine(seed);
+        std::uniform_int_distribution<std::uint64_t> distribution(0, 1000000);
+        std::vector<std::uint64_t> values(count);
+        std::generate(values.begin(), values.end(), [&]() { return distribution(engine); });
+        return values;
+    }
+} // namespace
+
+TEST(ExternalSort, SortsInMemoryWhenTheInputFitsTheBudget)
+{
+    const auto values{random_values(1000, 1)};
+    std::vector<std::uint64_t> sorted;
+    mu::external_sort(values.begin(), values.end(), std::back_inserter(sorted), 1_MiB, "/nonexistent");
+    auto expected{values};
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(sorted, expected);
+}
+
+TEST(ExternalSort, MergesSpilledRuns)
+{
+    const auto values{random_values(100000, 2)};
+    std::vector<std::uint64_t> sorted(values.size());
+    const auto end{mu::external_sort(values.begin(), values.end(), sorted.begin(), 64_kiB, "/tmp")};
+    EXPECT_EQ(end, sorted.end());
+    auto expected{values};
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(sorted, expected);
+}
+
+TEST(ExternalSort, MergesInSeveralPassesWhenTheBudgetHoldsFewBuffers)
+{
+    // A 1 kiB budget holds 128 values and merges at most two runs at once.
+    for (const auto count : {129u, 256u, 257u, 1000u, 10007u}) {
+        const auto values{random_values(count, count)};
+        std::vector<std::uint64_t> sorted;
+        mu::external_sort(values.begin(), values.end(), std::back_inserter(sorted), 1_kiB, "/tmp");
+        auto expected{values};
+        std::sort(expected.begin(), expected.end());
+        EXPECT_EQ(sorted, expected) << count;
+    }
+}
+
+TEST(ExternalSort, UsesTheComparatorAndAcceptsInputIterators)
+{
+    std::ostringstream text;
+    for (const auto value : random_values(5000, 3))
+        text << value << ' ';
+    std::istringstream input(text.str());
+    std::vector<std::uint64_t> sorted;
+    mu::external_sort(std::istream_iterator<std::uint64_t>(input), std::istream_iterator<std::uint64_t>(),
+                      std::back_inserter(sorted), 4_kiB, "/tmp", std::greater<std::uint64_t>());
+    ASSERT_EQ(sorted.size(), 5000u);
+    EXPECT_TRUE(std::is_sorted(sorted.begin(), sorted.end(), std::greater<std::uint64_t>()));
+}
+
+TEST(ExternalSort, SortsTriviallyCopyableRecords)
+{
+    struct record {
+        std::uint32_t key;
+        std::uint32_t sequence;
+    };
+    std::vector<record> records;
+    for (std::uint32_t i{0}; i < 3000; ++i)
+        records.push_back(record{(i * 7919) % 101, i});
+    std::vector<record> sorted;
+    mu::external_sort(records.begin(), records.end(), std::back_inserter(sorted), 2_kiB, "/tmp",
+                      [](const record &lhs, const record &rhs) { return lhs.key < rhs.key; });
+    ASSERT_EQ(sorted.size(), records.size());
+    EXPECT_TRUE(std::is_sorted(sorted.begin(), sorted.end(),
+                               [](const record &lhs, const record &rhs) { return lhs.key < rhs.key; }));
+}
+
+TEST(ExternalSort, RejectsUnusableBudgetsAndDirectories)
+{
+    const auto values{random_values(100, 4)};
+    std::vector<std::uint64_t> sorted;
+    EXPECT_THROW(mu::external_sort(values.begin(), values.end(), std::back_inserter(sorted), 64_B, "/tmp"),
+                 std::invalid_argument);
+    EXPECT_THROW(mu::external_sort(values.begin(), values.end(), std::back_inserter(sorted), 256_B, "/nonexistent"),
+                 std::system_error);
+}
+
+#endif
@@ -0,0 +1,136 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <type_traits>
+#include <vector>
+#include "memory_units_fixed.hpp"
+
+using namespace mu::literals;
+
+namespace
+{
+    using billing = mu::fixed<48, 16>;
+    using fixed_gigabytes = mu::memory_size<billing, mu::details::gb>;
+    using fixed_megabytes = mu::memory_size<billing, mu::details::mb>;
+} // namespace
+
+TEST(FixedRep, ConvertsFromAndToArithmeticTypes)
+{
+    EXPECT_EQ(billing(3).raw(), 3 * 65536);
+    EXPECT_EQ(billing(1.5).raw(), 98304);
+    EXPECT_EQ(billing(-0.25).raw(), -16384);
+    EXPECT_DOUBLE_EQ(static_cast<double>(billing(2.75)), 2.75);
+    EXPECT_EQ(static_cast<int>(billing(2.75)), 2);
+    EXPECT_EQ(static_cast<int>(billing(-2.75)), -2);
+    EXPECT_EQ((mu::fixed<32, 24>(billing(1.5)).raw()), 3 << 23);
+}
+
+TEST(FixedRep, ArithmeticIsExact)
+{
+    EXPECT_EQ(billing(1.5) + billing(2.25), billing(3.75));
+    EXPECT_EQ(billing(1.5) * billing(2.5), billing(3.75));
+    EXPECT_EQ(billing(7) / billing(2), billing(3.5));
+    EXPECT_EQ(-billing(1.5) * 2, billing(-3));
+
+    std::mt19937_64 generator{7};
+    std::vector<fixed_gigabytes> figures;
+    for (unsigned i{0}; i < 10000; ++i)
+        figures.emplace_back(billing::from_raw(static_cast<std::int64_t>(generator() % (1u << 30))));
+    const auto forward{std::accumulate(figures.cbegin(), figures.cend(), fixed_gigabytes::zero())};
+    const auto backward{std::accumulate(figures.crbegin(), figures.crend(), fixed_gigabytes::zero())};
+    std::shuffle(figures.begin(), figures.end(), generator);
+    const auto shuffled{std::accumulate(figures.cbegin(), figures.cend(), fixed_gigabytes::zero())};
+    EXPECT_EQ(forward.count().raw(), backward.count().raw());
+    EXPECT_EQ(forward.count().raw(), shuffled.count().raw());
+}
+
+TEST(FixedRep, CastsBetweenUnits)
+{
+    const fixed_gigabytes size{billing(1.5)};
+    EXPECT_EQ(mu::memory_size_cast<fixed_megabytes>(size).count(), billing(1500));
+    EXPECT_EQ(mu::memory_size_cast<mu::megabytes>(size), 1500_MB);
+    EXPECT_EQ(mu::memory_size_cast<fixed_gigabytes>(1250_MB).count(), billing(1.25));
+    EXPECT_NEAR(mu::memory_size_cast<mu::f_mebibytes>(fixed_megabytes(billing(1.048576))).count(), 1.0, 1e-4);
+    EXPECT_EQ((mu::memory_size_cast<mu::memory_size<billing, mu::details::kib>>(mu::f_mebibytes(0.5)).count()),
+              billing(512));
+}
+
+TEST(FixedRep, CommonTypes)
+{
+    EXPECT_TRUE((std::is_same<decltype(fixed_gigabytes(billing(1)) * 2), fixed_gigabytes>::value));
+    EXPECT_TRUE((std::is_same<decltype(fixed_gigabytes(billing(1)) + 1_MB), fixed_megabytes>::value));
+    EXPECT_TRUE((std::is_same<decltype(fixed_gigabytes(billing(1)) * 2.0),
+                              mu::memory_size<double, mu::details::gb>>::value));
+    EXPECT_TRUE((std::is_same<std::common_type<mu::fixed<32, 16>, mu::fixed<24, 32>>::type,
+                              mu::fixed<32, 32>>::value));
+    EXPECT_TRUE((std::is_same<std::common_type<mu::fixed<48, 16>, mu::fixed<16, 32>>::type,
+                              mu::fixed<32, 32>>::value));
+
+    EXPECT_EQ(fixed_gigabytes(billing(1.5)) + 250_MB, fixed_megabytes(billing(1750)));
+    EXPECT_LT(fixed_gigabytes(billing(0.999)), 1_GB);
+    EXPECT_EQ((fixed_gigabytes(billing(1)) * 2.5).count(), 2.5);
+    EXPECT_EQ(fixed_gigabytes::max().count().raw(), std::numeric_limits<std::int64_t>::max());
+}
+
+TEST(FixedRep, PortableMultiplyDivideMatchesTheWideOne)
+{
+    const std::int64_t largest{std::numeric_limits<std::int64_t>::max()};
+    EXPECT_EQ(mu::details::portable_multiply_divide(7, 3, 2), 10);
+    EXPECT_EQ(mu::details::portable_multiply_divide(-7, 3, 2), -10);
+    EXPECT_EQ(mu::details::portable_multiply_divide(7, -3, -2), 10);
+    EXPECT_EQ(mu::details::portable_multiply_divide(largest, largest, largest), largest);
+    EXPECT_EQ(mu::details::portable_multiply_divide(-largest - 1, 1000, 1000), -largest - 1);
+    EXPECT_EQ(mu::details::portable_multiply_divide(largest, 1000000000, 1000000007), 9223371972291172000);
+
+    std::mt19937_64 generator{11};
+    for (unsigned i{0}; i < 10000; ++i) {
+        const auto value{static_cast<std::int64_t>(generator())};
+        const auto numerator{static_cast<std::int64_t>(generator() >> (generator() % 64))};
+        const auto denominator{static_cast<std::int64_t>(generator() | 1)};
+        if (mu::details::magnitude(numerator) > mu::details::magnitude(denominator))
+            continue;
+        ASSERT_EQ(mu::details::portable_multiply_divide(value, numerator, denominator),
+                  mu::details::multiply_divide_wide(value, numerator, denominator));
+    }
+}
+
+TEST(FixedRep, SumsAndCastsSizeVectors)
+{
+    mu::size_vector<mu::details::gb, billing> figures;
+    std::mt19937_64 generator{13};
+    auto expected{fixed_gigabytes::zero()};
+    for (unsigned i{0}; i < 1000; ++i) {
+        const fixed_gigabytes figure{billing::from_raw(static_cast<std::int64_t>(generator() % (1u << 30)))};
+        figures.push_back(figure);
+        expected += figure;
+    }
+    EXPECT_EQ(mu::sum(figures), expected);
+
+    const auto in_megabytes{mu::memory_size_cast<fixed_megabytes>(figures)};
+    EXPECT_TRUE((std::is_same<decltype(in_megabytes), const mu::size_vector<mu::details::mb, billing>>::value));
+    ASSERT_EQ(in_megabytes.size(), figures.size());
+    for (std::size_t i{0}; i < figures.size(); ++i)
+        EXPECT_EQ(in_megabytes[i], mu::memory_size_cast<fixed_megabytes>(figures[i]));
+    EXPECT_EQ(mu::sum(in_megabytes), mu::memory_size_cast<fixed_megabytes>(expected));
+}
@@ -0,0 +1,155 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include "memory_units_layout.hpp"
+
+using namespace mu::literals;
+
+namespace
+{
+    struct packet {
+        std::uint8_t kind;
+        std::uint64_t length;
+        std::uint16_t flags;
+    };
+
+    struct counters {
+        std::uint64_t reads[8];
+        std::uint64_t writes;
+        std::uint32_t errors;
+    };
+
+    struct alignas(64) padded_counters {
+        std::uint64_t reads;
+        alignas(64) std::uint64_t writes;
+    };
+
+    constexpr auto packet_layout{
+            mu::layout_of<packet>(MU_FIELD(packet, length), MU_FIELD(packet, kind), MU_FIELD(packet, flags))};
+    constexpr auto counters_layout{mu::layout_of<counters>(MU_FIELD(counters, reads), MU_FIELD(counters, writes),
+                                                           MU_FIELD(counters, errors))};
+    constexpr auto padded_layout{
+            mu::layout_of<padded_counters>(MU_FIELD(padded_counters, reads), MU_FIELD(padded_counters, writes))};
+} // namespace
+
+TEST(Layout, SizesAndAlignments)
+{
+    static_assert(mu::size_of<std::uint64_t> == 8_B, "");
+    static_assert(mu::align_of<padded_counters> == 1_B * 64, "");
+    static_assert(mu::size_of<padded_counters> == mu::cache_lines(2), "");
+    static_assert(mu::fits_in<packet, mu::cache_lines>(1), "");
+    static_assert(!mu::fits_in<counters, mu::cache_lines>(1), "");
+    static_assert(mu::assert_fits_in<counters, mu::cache_lines, 2>::value, "");
+    static_assert(mu::units_touched<std::uint64_t[8], mu::cache_lines>() == mu::cache_lines(2), "");
+    static_assert(mu::units_touched<padded_counters, mu::cache_lines>() == mu::cache_lines(2), "");
+    static_assert(mu::units_touched<char[64], mu::cache_lines>() == mu::cache_lines(2), "");
+    static_assert(mu::units_touched<std::uint32_t, mu::cache_lines>() == mu::cache_lines(1), "");
+    SUCCEED();
+}
+
+TEST(Layout, ReportsPadding)
+{
+    static_assert(packet_layout.field_count() == 3, "");
+    static_assert(packet_layout.padding() == 13_B, "");
+    static_assert(packet_layout.internal_padding() == 7_B, "");
+    static_assert(packet_layout.tail_padding() == 6_B, "");
+    EXPECT_STREQ(packet_layout.field(0).name, "kind");
+    EXPECT_EQ(packet_layout.padding_before(1), 7_B);
+    EXPECT_EQ(packet_layout.index_of("flags"), 2u);
+    EXPECT_THROW(static_cast<void>(packet_layout.index_of("missing")), std::invalid_argument);
+    static_assert(counters_layout.padding() == 4_B, "");
+}
+
+TEST(Layout, ReportsCacheLines)
+{
+    static_assert(counters_layout.cache_line_count() == mu::cache_lines(2), "");
+    static_assert(!counters_layout.straddles_cache_line(0), "");
+    static_assert(counters_layout.share_cache_line("writes", "errors"), "");
+    static_assert(!counters_layout.share_cache_line("reads", "writes"), "");
+    static_assert(!padded_layout.share_cache_line("reads", "writes"), "");
+    static_assert(padded_layout.padding() == 112_B, "");
+    EXPECT_EQ(counters_layout.first_cache_line(1), 1u);
+    EXPECT_THROW(static_cast<void>(counters_layout.share_cache_line("writes", "typo")), std::invalid_argument);
+}
+
+TEST(Layout, DescribesTheLayout)
+{
+    const auto description{packet_layout.describe()};
+    EXPECT_NE(description.find("size 24 alignment 8 padding 13 cache lines 1"), std::string::npos);
+    EXPECT_NE(description.find("  [padding] offset 1 size 7\n"), std::string::npos);
+    EXPECT_NE(description.find("  length offset 8 size 8 cache line 0\n"), std::string::npos);
+    EXPECT_NE(description.find("  [padding] offset 18 size 6\n"), std::string::npos);
+}
+
+#if __cplusplus >= 201703L
+TEST(Layout, EnumeratesAggregateMembers)
+{
+    const auto enumerated{mu::layout_of<packet>()};
+    static_assert(decltype(enumerated)::field_count() == 3, "");
+    EXPECT_EQ(enumerated.padding(), packet_layout.padding());
+    EXPECT_EQ(enumerated.field(1).offset, 8_B);
+    EXPECT_STREQ(enumerated.field(2).name, "2");
+
+    // Arrays count as one member
+    const auto with_array{mu::layout_of<counters>()};
+    static_assert(decltype(with_array)::field_count() == 3, "");
+    EXPECT_EQ(with_array.field(0).size, 64_B);
+    EXPECT_EQ(with_array.padding(), counters_layout.padding());
+    EXPECT_FALSE(with_array.share_cache_line("0", "1"));
+    EXPECT_EQ(mu::layout_of<padded_counters>().field(1).offset, 64_B);
+}
+
+namespace
+{
+    struct two_halves {
+        two_halves() = default;
+        two_halves(std::uint32_t low, std::uint32_t high) : value((std::uint64_t{high} << 32) | low) {}
+        std::uint64_t value{0};
+    };
+
+    struct constructed_once {
+        constructed_once() { ++constructions; }
+        static int constructions;
+        char tag;
+    };
+
+    int constructed_once::constructions{0};
+
+    struct handles {
+        two_halves first;
+        constructed_once second;
+        std::uint32_t third;
+    };
+} // namespace
+
+TEST(Layout, EnumeratesMembersOfAnObjectConstructedOnce)
+{
+    const auto enumerated{mu::layout_of<handles>()};
+    static_assert(decltype(enumerated)::field_count() == 3, "");
+    EXPECT_EQ(enumerated.field(1).offset, mu::bytes(offsetof(handles, second)));
+    EXPECT_EQ(enumerated.field(2).size, 4_B);
+    EXPECT_EQ(mu::layout_of<handles>().field(2).offset, mu::bytes(offsetof(handles, third)));
+    EXPECT_EQ(constructed_once::constructions, 1);
+}
+#endif
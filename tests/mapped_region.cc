@@ -0,0 +1,155 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#if defined(__linux__)
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include <sys/prctl.h>
+#include <gtest/gtest.h>
+#include "memory_units_mapped_region.hpp"
+
+using namespace mu::literals;
+
+namespace
+{
+    bool resident(const mu::mapped_region &region)
+    {
+        const auto page{mu::details::page_bytes()};
+        std::vector<unsigned char> pages(static_cast<std::size_t>(region.size().count()) / page);
+        if (::mincore(region.data(), static_cast<std::size_t>(region.size().count()), pages.data()) != 0)
+            return false;
+        for (const auto page_state : pages)
+            if ((page_state & 1) == 0)
+                return false;
+        return true;
+    }
+} // namespace
+
+TEST(MappedRegion, RoundsToWholePages)
+{
+    const mu::mapped_region region{10_kB};
+    const auto page{mu::details::page_bytes()};
+    EXPECT_EQ(region.size().count() % page, 0u);
+    EXPECT_GE(region.size(), 10_kB);
+    EXPECT_LT(region.size(), 10_kB + mu::bytes(page));
+    region.data<std::uint64_t>()[0] = 42;
+    EXPECT_EQ(region.data<std::uint64_t>()[0], 42u);
+}
+
+TEST(MappedRegion, AlignsTransparentHugePages)
+{
+    const mu::mapped_region region{3_MiB, mu::huge_page_policy::transparent};
+    EXPECT_EQ(region.size(), 4_MiB);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(region.data()) % (2 * 1024 * 1024), 0u);
+    EXPECT_EQ(region.huge_pages_policy(), mu::huge_page_policy::transparent);
+}
+
+TEST(MappedRegion, Prefaults)
+{
+    for (const auto prefault : {mu::prefault_policy::populate, mu::prefault_policy::touch}) {
+        mu::mapped_region_options options;
+        options.prefault = prefault;
+        options.touch_threads = 4;
+        const mu::mapped_region region{1_MiB, mu::huge_page_policy::none, options};
+        EXPECT_TRUE(resident(region));
+        const mu::mapped_region advised{2_MiB, mu::huge_page_policy::transparent, options};
+        EXPECT_TRUE(resident(advised));
+    }
+}
+
+TEST(MappedRegion, TouchesEveryBasePageWithoutTransparentHugePages)
+{
+    // Transparent huge pages stay advisory: once disabled for the process, the advised region is backed by base
+    // pages that must all be faulted in.
+    const auto disabled{::prctl(PR_GET_THP_DISABLE, 0, 0, 0, 0)};
+    ASSERT_EQ(::prctl(PR_SET_THP_DISABLE, 1, 0, 0, 0), 0);
+    mu::mapped_region_options options;
+    options.prefault = mu::prefault_policy::touch;
+    options.touch_threads = 2;
+    const mu::mapped_region region{4_MiB, mu::huge_page_policy::transparent, options};
+    ::prctl(PR_SET_THP_DISABLE, disabled, 0, 0, 0);
+    EXPECT_TRUE(resident(region));
+}
+
+TEST(MappedRegion, FailsWhenTheHugePagePoolIsTooSmall)
+{
+    std::uint64_t free_pages{0};
+    std::uint64_t overcommit{0};
+    if (auto file{std::fopen("/proc/meminfo", "r")}) {
+        char line[256];
+        while (std::fgets(line, sizeof(line), file))
+            std::sscanf(line, "HugePages_Free: %" SCNu64, &free_pages);
+        std::fclose(file);
+    }
+    if (auto file{std::fopen("/proc/sys/vm/nr_overcommit_hugepages", "r")}) {
+        if (std::fscanf(file, "%" SCNu64, &overcommit) != 1)
+            overcommit = 0;
+        std::fclose(file);
+    }
+    if (overcommit != 0)
+        GTEST_SKIP() << "Surplus huge pages can be allocated beyond the pool";
+    const mu::bytes beyond_the_pool{(free_pages + 1) * 2 * 1024 * 1024};
+    EXPECT_THROW(mu::mapped_region(beyond_the_pool, mu::huge_page_policy::reserved), std::system_error);
+}
+
+TEST(MappedRegion, LocksWhenAllowed)
+{
+    mu::mapped_region_options options;
+    options.lock = true;
+    try {
+        const mu::mapped_region region{64_kiB, mu::huge_page_policy::none, options};
+        EXPECT_TRUE(region.is_locked());
+        EXPECT_TRUE(resident(region));
+    }
+    catch (const std::system_error &error) {
+        EXPECT_TRUE(error.code() == std::errc::operation_not_permitted ||
+                    error.code() == std::errc::not_enough_memory);
+    }
+}
+
+TEST(MappedRegion, BindsToANumaNode)
+{
+    mu::mapped_region_options options;
+    options.numa = mu::numa_policy::bind;
+    options.numa_nodes = 1;
+    try {
+        mu::mapped_region region{64_kiB, mu::huge_page_policy::none, options};
+        region.data<char>()[0] = 1;
+    }
+    catch (const std::system_error &error) {
+        // Kernels built without NUMA support or sandboxes forbidding mbind
+        EXPECT_TRUE(error.code() == std::errc::function_not_supported ||
+                    error.code() == std::errc::operation_not_permitted);
+    }
+}
+
+TEST(MappedRegion, MovesAndRejectsEmptyRegions)
+{
+    mu::mapped_region region{4_kiB};
+    const auto address{region.data()};
+    const auto moved{std::move(region)};
+    EXPECT_EQ(moved.data(), address);
+    EXPECT_EQ(region.data(), nullptr);
+    EXPECT_THROW(mu::mapped_region{0_B}, std::invalid_argument);
+}
+
+#endif
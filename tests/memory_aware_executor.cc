@@ -0,0 +1,311 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "memory_units_executor.hpp"
+
+using namespace mu::literals;
+
+namespace
+{
+    // Keeps a task running until released, recording the declared footprint in flight.
+    class gate {
+    public:
+        void open()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                opened = true;
+            }
+            condition.notify_all();
+        }
+
+        void wait()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this]() { return opened; });
+        }
+
+    private:
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool opened{false};
+    };
+
+    template<typename Predicate>
+    bool eventually(Predicate predicate)
+    {
+        const auto deadline{std::chrono::steady_clock::now() + std::chrono::seconds(5)};
+        while (!predicate()) {
+            if (std::chrono::steady_clock::now() > deadline)
+                return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+} // namespace
+
+TEST(MemoryAwareExecutor, ReturnsTaskResults)
+{
+    mu::memory_aware_executor executor(1_MiB, 2);
+    auto answer{executor.submit(1_kiB, []() { return 42; })};
+    auto failure{executor.submit(1_kiB, []() -> int { throw std::runtime_error("failure"); })};
+    EXPECT_EQ(answer.get(), 42);
+    EXPECT_THROW(failure.get(), std::runtime_error);
+    EXPECT_EQ(executor.budget(), 1_MiB);
+}
+
+TEST(MemoryAwareExecutor, KeepsRunningFootprintUnderBudget)
+{
+    mu::memory_aware_executor executor(10_kiB, 8);
+    std::atomic<std::uint64_t> in_flight{0};
+    std::atomic<std::uint64_t> highest{0};
+    std::vector<std::future<void>> results;
+    for (std::uint64_t i{0}; i < 64; ++i) {
+        const auto footprint{1 + i % 4};
+        results.push_back(executor.submit(mu::kibibytes(footprint), [&, footprint]() {
+            const auto now{in_flight += footprint * 1024};
+            auto seen{highest.load()};
+            while (now > seen && !highest.compare_exchange_weak(seen, now)) {
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            in_flight -= footprint * 1024;
+        }));
+    }
+    for (auto &result : results)
+        result.get();
+    executor.wait_idle();
+    EXPECT_LE(highest.load(), 10 * 1024u);
+    EXPECT_EQ(executor.reserved(), 0_B);
+    EXPECT_EQ(executor.pending_count(), 0u);
+}
+
+TEST(MemoryAwareExecutor, BackfillsSmallTasksAroundLargeOnes)
+{
+    mu::memory_aware_executor executor(10_kiB, 4);
+    gate release;
+    auto running{executor.submit(8_kiB, [&]() { release.wait(); })};
+    ASSERT_TRUE(eventually([&]() { return executor.reserved() == 8_kiB; }));
+    std::atomic<bool> large_started{false};
+    auto waiting{executor.submit(8_kiB, [&]() { large_started = true; })};
+    auto small{executor.submit(1_kiB, []() { return true; })};
+    EXPECT_TRUE(small.get());
+    EXPECT_FALSE(large_started.load());
+    release.open();
+    running.get();
+    waiting.get();
+    EXPECT_TRUE(large_started.load());
+}
+
+TEST(MemoryAwareExecutor, StopsBackfillingWhenTheHeadWaitsTooLong)
+{
+    // Two workers allow at most eight tasks to be backfilled around a waiting one.
+    mu::memory_aware_executor executor(10_kiB, 2);
+    gate release;
+    auto running{executor.submit(8_kiB, [&]() { release.wait(); })};
+    ASSERT_TRUE(eventually([&]() { return executor.reserved() == 8_kiB; }));
+    auto waiting{executor.submit(8_kiB, []() {})};
+    std::atomic<int> started{0};
+    std::vector<std::future<void>> small;
+    for (int i{0}; i < 16; ++i)
+        small.push_back(executor.submit(1_kiB, [&]() { ++started; }));
+    ASSERT_TRUE(eventually([&]() { return started.load() == 8; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(started.load(), 8);
+    EXPECT_EQ(executor.pending_count(), 9u);
+    release.open();
+    running.get();
+    waiting.get();
+    for (auto &result : small)
+        result.get();
+    EXPECT_EQ(started.load(), 16);
+}
+
+TEST(MemoryAwareExecutor, RunsOversizedTasksAlone)
+{
+    mu::memory_aware_executor executor(1_kiB, 4);
+    std::atomic<int> concurrent{0};
+    std::atomic<int> highest{0};
+    std::vector<std::future<void>> results;
+    for (int i{0}; i < 8; ++i) {
+        results.push_back(executor.submit(4_kiB, [&]() {
+            const auto now{++concurrent};
+            auto seen{highest.load()};
+            while (now > seen && !highest.compare_exchange_weak(seen, now)) {
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            --concurrent;
+        }));
+    }
+    for (auto &result : results)
+        result.get();
+    EXPECT_EQ(highest.load(), 1);
+}
+
+TEST(MemoryAwareExecutor, LearnsEstimatesFromObservedGrowth)
+{
+    std::atomic<std::uint64_t> resident{0};
+    mu::memory_aware_executor executor(1_MiB, 1, [&]() { return mu::bytes(resident.load()); });
+    EXPECT_DOUBLE_EQ(executor.correction("decode"), 1.0);
+    executor.submit("decode", 1_kiB, [&]() { resident += 4096; }).get();
+    executor.wait_idle();
+    EXPECT_DOUBLE_EQ(executor.correction("decode"), 4.0);
+    executor.submit("decode", 1_kiB, [&]() { resident += 2048; }).get();
+    executor.wait_idle();
+    EXPECT_DOUBLE_EQ(executor.correction("decode"), 3.5);
+
+    gate release;
+    auto corrected{executor.submit("decode", 1_kiB, [&]() { release.wait(); })};
+    EXPECT_TRUE(eventually([&]() { return executor.reserved() == 3584_B; }));
+    release.open();
+    corrected.get();
+    EXPECT_DOUBLE_EQ(executor.correction("other"), 1.0);
+}
+
+TEST(MemoryAwareExecutor, LearnsFromThePeakOfTasksFreeingTheirMemory)
+{
+    std::atomic<std::uint64_t> resident{0};
+    mu::memory_aware_executor executor(1_MiB, 1, [&]() { return mu::bytes(resident.load()); });
+    executor.submit("transient", 1_kiB, [&]() {
+                resident += 8192;
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                resident -= 8192;
+            })
+            .get();
+    executor.wait_idle();
+    EXPECT_DOUBLE_EQ(executor.correction("transient"), 8.0);
+
+    // Nothing observed at all: estimates never shrink below the declared footprint
+    for (int i{0}; i < 8; ++i)
+        executor.submit("free", 1_kiB, []() {}).get();
+    executor.wait_idle();
+    EXPECT_DOUBLE_EQ(executor.correction("free"), 1.0);
+    gate release;
+    auto charged{executor.submit("free", 1_kiB, [&]() { release.wait(); })};
+    EXPECT_TRUE(eventually([&]() { return executor.reserved() == 1_kiB; }));
+    release.open();
+    charged.get();
+}
+
+TEST(MemoryAwareExecutor, NeverChargesLessThanTheDeclaredFootprint)
+{
+    std::atomic<std::uint64_t> resident{0};
+    mu::memory_aware_executor executor(1_MiB, 1, [&]() { return mu::bytes(resident.load()); });
+    executor.submit("parse", 16_kiB, [&]() { resident += 8192; }).get();
+    executor.wait_idle();
+    EXPECT_DOUBLE_EQ(executor.correction("parse"), 1.0);
+}
+
+TEST(MemoryAwareExecutor, StaysUnderBudgetWhenTheProbeNeverMoves)
+{
+    // An allocator reusing the memory freed by the previous tasks: the probe never sees any growth
+    mu::memory_aware_executor executor(4_kiB, 8, []() { return mu::bytes(1048576); });
+    std::atomic<std::uint64_t> in_flight{0};
+    std::atomic<std::uint64_t> highest{0};
+    std::atomic<std::uint64_t> highest_reserved{0};
+    std::vector<std::future<void>> results;
+    for (int i{0}; i < 200; ++i) {
+        results.push_back(executor.submit("reused", 1_kiB, [&]() {
+            const auto now{in_flight += 1024};
+            auto seen{highest.load()};
+            while (now > seen && !highest.compare_exchange_weak(seen, now)) {
+            }
+            const auto reserved{executor.reserved().count()};
+            seen = highest_reserved.load();
+            while (reserved > seen && !highest_reserved.compare_exchange_weak(seen, reserved)) {
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            in_flight -= 1024;
+        }));
+    }
+    for (auto &result : results)
+        result.get();
+    executor.wait_idle();
+    EXPECT_DOUBLE_EQ(executor.correction("reused"), 1.0);
+    EXPECT_LE(highest.load(), executor.budget().count());
+    EXPECT_LE(highest_reserved.load(), executor.budget().count());
+}
+
+TEST(MemoryAwareExecutor, SplitsTheGrowthOfConcurrentTasks)
+{
+    std::atomic<std::uint64_t> resident{0};
+    mu::memory_aware_executor executor(1_MiB, 2, [&]() { return mu::bytes(resident.load()); });
+    std::atomic<int> started{0};
+    gate grow;
+    gate release;
+    auto small{executor.submit("small", 1_kiB, [&]() {
+        ++started;
+        grow.wait();
+        release.wait();
+    })};
+    auto large{executor.submit("large", 3_kiB, [&]() {
+        ++started;
+        grow.wait();
+        resident += 8192;
+        release.wait();
+    })};
+    ASSERT_TRUE(eventually([&]() { return started.load() == 2; }));
+    grow.open();
+    ASSERT_TRUE(eventually([&]() { return resident.load() == 8192; }));
+    release.open();
+    small.get();
+    large.get();
+    executor.wait_idle();
+    EXPECT_DOUBLE_EQ(executor.correction("small"), 2.0);
+    EXPECT_DOUBLE_EQ(executor.correction("large"), 2.0);
+}
+
+TEST(MemoryAwareExecutor, ConvergesWhileTasksOverlap)
+{
+    std::atomic<std::uint64_t> resident{0};
+    mu::memory_aware_executor executor(1_MiB, 2, [&]() { return mu::bytes(resident.load()); });
+    // A spike observed once, then tasks using four times their declared footprint, always two at a time
+    executor.submit("decode", 1_kiB, [&]() { resident += 16384; }).get();
+    executor.wait_idle();
+    EXPECT_DOUBLE_EQ(executor.correction("decode"), 16.0);
+    for (int round{0}; round < 20; ++round) {
+        std::atomic<int> started{0};
+        gate grow;
+        gate release;
+        std::vector<std::future<void>> pair;
+        for (int i{0}; i < 2; ++i)
+            pair.push_back(executor.submit("decode", 1_kiB, [&]() {
+                ++started;
+                grow.wait();
+                resident += 4096;
+                release.wait();
+            }));
+        ASSERT_TRUE(eventually([&]() { return started.load() == 2; }));
+        const auto before{resident.load()};
+        grow.open();
+        ASSERT_TRUE(eventually([&]() { return resident.load() == before + 8192; }));
+        release.open();
+        for (auto &task : pair)
+            task.get();
+        executor.wait_idle();
+    }
+    EXPECT_NEAR(executor.correction("decode"), 4.0, 0.01);
+}
@@ -0,0 +1,95 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <type_traits>
+#include "memory_units_rate.hpp"
+
+using namespace mu::literals;
+using namespace std::chrono_literals;
+
+TEST(MemoryRate, SizeOverDuration)
+{
+    const auto rate{100_MiB / 4s};
+    EXPECT_TRUE((std::is_same<decltype(rate), const mu::mebibytes_per_second>::value));
+    EXPECT_EQ(rate.count(), 25u);
+    const auto fine{mu::f_bytes(3000) / std::chrono::milliseconds(2)};
+    EXPECT_TRUE((std::is_same<decltype(fine)::period, std::milli>::value));
+    EXPECT_DOUBLE_EQ(fine.count(), 1500.0);
+}
+
+TEST(MemoryRate, RateCast)
+{
+    static_assert(mu::rate_cast<mu::kibibytes_per_second>(mu::mebibytes_per_second(3)).count() == 3072,
+                  "Scaled at compile time");
+    EXPECT_EQ(mu::rate_cast<mu::megabits_per_second>(mu::megabytes_per_second(10)).count(), 80u);
+    EXPECT_EQ(mu::rate_cast<mu::bytes_per_second>(mu::gigabits_per_second(1)).count(), 125000000u);
+    const auto per_nanosecond{mu::memory_rate<double, std::ratio<1>, std::nano>(2.0)};
+    EXPECT_DOUBLE_EQ(mu::rate_cast<mu::f_gigabytes_per_second>(per_nanosecond).count(), 2.0);
+    EXPECT_NEAR(mu::rate_cast<mu::f_gibibytes_per_second>(per_nanosecond).count(), 1.862645, 1e-6);
+    EXPECT_EQ(mu::rate_cast<mu::mebibytes_per_second>(mu::kibibytes_per_second(3000)).count(), 2u);
+}
+
+TEST(MemoryRate, ExactConversions)
+{
+    const mu::kibibytes_per_second from_mebibytes(mu::mebibytes_per_second(2));
+    EXPECT_EQ(from_mebibytes.count(), 2048u);
+    const mu::memory_rate<std::uint64_t, mu::details::kb, std::milli> per_millisecond(
+            mu::memory_rate<std::uint64_t, mu::details::mb>(3));
+    EXPECT_EQ(per_millisecond.count(), 3u);
+    const mu::f_mebibytes_per_second from_kibibytes(mu::kibibytes_per_second(512));
+    EXPECT_DOUBLE_EQ(from_kibibytes.count(), 0.5);
+}
+
+TEST(MemoryRate, RateTimesDuration)
+{
+    const auto size{mu::mebibytes_per_second(100) * 3s};
+    EXPECT_EQ(size, 300_MiB);
+    EXPECT_EQ(mu::mebibytes_per_second(100) * 250ms, 25_MiB);
+    EXPECT_EQ(2min * mu::kilobytes_per_second(5), 600_kB);
+    EXPECT_EQ(mu::memory_size_cast<mu::bytes>(mu::gigabits_per_second(8) * 1ns), 1_B);
+}
+
+TEST(MemoryRate, SizeOverRate)
+{
+    const auto duration{1_GiB / mu::mebibytes_per_second(256)};
+    EXPECT_EQ(std::chrono::duration_cast<std::chrono::seconds>(duration), 4s);
+    // Integral quotients truncate like std::chrono, floating ones keep the fraction.
+    EXPECT_EQ(1_MB / mu::kilobytes_per_second(400), 2s);
+    const auto transfer{mu::f_megabytes(1) / mu::kilobytes_per_second(400)};
+    EXPECT_EQ(std::chrono::duration_cast<std::chrono::milliseconds>(transfer), 2500ms);
+}
+
+TEST(MemoryRate, ArithmeticAndComparisons)
+{
+    EXPECT_EQ(mu::mebibytes_per_second(1) + mu::kibibytes_per_second(512), mu::kibibytes_per_second(1536));
+    EXPECT_EQ(mu::mebibytes_per_second(1) - mu::kibibytes_per_second(512), mu::kibibytes_per_second(512));
+    EXPECT_EQ(mu::mebibytes_per_second(3) * 2, mu::mebibytes_per_second(6));
+    EXPECT_EQ(mu::mebibytes_per_second(6) / 3, mu::mebibytes_per_second(2));
+    auto rate{mu::megabytes_per_second(10)};
+    rate += mu::megabytes_per_second(5);
+    rate *= 2;
+    EXPECT_EQ(rate.count(), 30u);
+    EXPECT_LT(mu::gigabits_per_second(1), mu::gigabytes_per_second(1));
+    EXPECT_GT(mu::mebibytes_per_second(1), mu::megabytes_per_second(1));
+    EXPECT_EQ((mu::memory_rate<std::uint64_t, std::ratio<1>, std::milli>(1)), mu::kilobytes_per_second(1));
+    EXPECT_NE(mu::bytes_per_second(1), mu::bytes_per_second::zero());
+}
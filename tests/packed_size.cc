@@ -0,0 +1,132 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "memory_units_packed.hpp"
+
+using namespace mu::literals;
+
+namespace
+{
+    template<typename Packed>
+    double worst_relative_error(const std::vector<std::uint64_t> &values)
+    {
+        auto worst{0.0};
+        for (const auto value : values) {
+            const auto decoded{Packed(mu::bytes(value)).size().count()};
+            const auto error{static_cast<double>(decoded > value ? decoded - value : value - decoded)};
+            worst = std::max(worst, value == 0 ? error : error / static_cast<double>(value));
+        }
+        return worst;
+    }
+
+    std::vector<std::uint64_t> random_sizes()
+    {
+        std::mt19937_64 generator{42};
+        std::vector<std::uint64_t> values;
+        for (unsigned width{0}; width < 64; ++width)
+            for (unsigned i{0}; i < 500; ++i)
+                values.push_back(generator() >> width);
+        return values;
+    }
+} // namespace
+
+TEST(PackedSize, HasTheRequestedWidth)
+{
+    EXPECT_EQ(sizeof(mu::packed_size<16>), 2u);
+    EXPECT_EQ(sizeof(mu::packed_size<24>), 3u);
+    EXPECT_EQ(sizeof(mu::packed_size<24>[4]), 12u);
+    EXPECT_EQ(sizeof(mu::packed_size<32>), 4u);
+    EXPECT_EQ(sizeof(mu::packed_size<40>), 5u);
+    EXPECT_EQ(sizeof(mu::packed_size<48>), 6u);
+    EXPECT_EQ(sizeof(mu::packed_size<48>[4]), 24u);
+}
+
+TEST(PackedSize, LogScaleKeepsSmallSizesExact)
+{
+    for (std::uint64_t value{0}; value < 2048; ++value)
+        EXPECT_EQ(mu::packed_size<16>(mu::bytes(value)).size(), mu::bytes(value));
+    EXPECT_EQ(mu::packed_size<32>(64_MiB).size(), 64_MiB);
+    EXPECT_EQ(mu::packed_size<16>(1_GiB).as<mu::mebibytes>(), 1024_MiB);
+}
+
+TEST(PackedSize, LogScaleBoundsTheRelativeError)
+{
+    const auto values{random_sizes()};
+    EXPECT_LE(worst_relative_error<mu::packed_size<16>>(values), 1.0 / 2048);
+    EXPECT_LE(worst_relative_error<mu::packed_size<24>>(values), 1.0 / (1u << 19));
+    EXPECT_LE(worst_relative_error<mu::packed_size<32>>(values), 1.0 / (1u << 27));
+    EXPECT_LE((worst_relative_error<mu::packed_size<16, std::ratio<1, 100>>>(values)), 0.01);
+    EXPECT_GT((worst_relative_error<mu::packed_size<16, std::ratio<1, 100>>>(values)), 1.0 / 2048);
+}
+
+TEST(PackedSize, LogScaleCoversTheWholeRange)
+{
+    const auto largest{mu::packed_size<16>::max().count()};
+    EXPECT_GT(largest, std::numeric_limits<std::uint64_t>::max() - (std::numeric_limits<std::uint64_t>::max() >> 10));
+    EXPECT_EQ(mu::packed_size<16>(mu::bytes(std::numeric_limits<std::uint64_t>::max())).size().count(), largest);
+    EXPECT_EQ(mu::packed_size<32>(16_EiB - 1_B).size(), mu::packed_size<32>::max());
+    EXPECT_EQ(mu::packed_size<24>(16_EiB - 1_B).size(), mu::packed_size<24>::max());
+    EXPECT_EQ(mu::packed_size<24>(64_kiB).size(), 64_kiB);
+}
+
+TEST(PackedSize, LogScaleCodesAreOrdered)
+{
+    auto previous{mu::packed_size<16>(0_B)};
+    for (std::uint64_t value{1}; value < (std::uint64_t{1} << 40); value = value * 5 / 4 + 1) {
+        const mu::packed_size<16> packed{mu::bytes(value)};
+        EXPECT_LE(previous.raw(), packed.raw());
+        EXPECT_LE(previous, packed);
+        previous = packed;
+    }
+}
+
+TEST(PackedSize, ExactVariantsRoundTrip)
+{
+    for (const auto value : random_sizes()) {
+        const auto expected{std::min(value, (std::uint64_t{1} << 40) - 1)};
+        EXPECT_EQ(mu::packed_size<40>(mu::bytes(value)).size().count(), expected);
+        if (value < (std::uint64_t{1} << 48)) {
+            EXPECT_EQ(mu::packed_size<48>(mu::bytes(value)).size().count(), value);
+        }
+    }
+    EXPECT_EQ(mu::packed_size<40>::max(), 1_TiB - 1_B);
+    EXPECT_EQ(mu::packed_size<48>(3_GB).as<mu::megabytes>(), 3000_MB);
+}
+
+TEST(PackedSize, EncodesAndDecodesInBulk)
+{
+    const std::vector<mu::kibibytes> sizes{4_kiB, 1000_kiB, 3072_kiB, 2097152_kiB};
+    std::vector<mu::packed_size<48>> packed(sizes.size());
+    mu::packed_size<48>::encode(sizes.cbegin(), sizes.cend(), packed.begin());
+    std::vector<mu::bytes> decoded(sizes.size());
+    mu::packed_size<48>::decode(packed.cbegin(), packed.cend(), decoded.begin());
+    for (std::size_t i{0}; i < sizes.size(); ++i)
+        EXPECT_EQ(decoded[i], sizes[i]);
+}
+
+TEST(PackedSize, EncodesAtCompileTime)
+{
+    constexpr mu::packed_size<16> packed{1_MiB};
+    static_assert(packed.size() == 1_MiB, "Powers of two are exact");
+}
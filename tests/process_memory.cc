@@ -0,0 +1,133 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#if defined(__linux__)
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "memory_units_process_memory.hpp"
+
+using namespace mu::literals;
+
+namespace
+{
+    class FakeProcDirectory : public ::testing::Test {
+    protected:
+        void SetUp() override
+        {
+            char pattern[] = "/tmp/mu_proc_XXXXXX";
+            ASSERT_NE(::mkdtemp(pattern), nullptr);
+            directory = pattern;
+            write("status", "Name:\tservice\n"
+                            "VmPeak:\t  3348 kB\n"
+                            "VmHWM:\t    4096 kB\n"
+                            "VmRSS:\t    2048 kB\n"
+                            "RssAnon:\t     512 kB\n"
+                            "RssFile:\t    1500 kB\n"
+                            "RssShmem:\t      36 kB\n"
+                            "VmSwap:\t      12 kB\n"
+                            "Threads:\t4\n");
+            write("statm", "660 353 327 5 0 123 0\n");
+        }
+
+        void TearDown() override
+        {
+            for (const auto name : {"status", "statm", "smaps_rollup"})
+                std::remove((directory + "/" + name).c_str());
+            ::rmdir(directory.c_str());
+        }
+
+        void write(const std::string &name, const std::string &content) const
+        {
+            auto file{std::fopen((directory + "/" + name).c_str(), "w")};
+            ASSERT_NE(file, nullptr);
+            std::fputs(content.c_str(), file);
+            std::fclose(file);
+        }
+
+        std::string directory;
+    };
+} // namespace
+
+TEST_F(FakeProcDirectory, ParsesStatus)
+{
+    const mu::process_memory::sampler sampler(directory);
+    const auto usage{sampler.snapshot()};
+    EXPECT_EQ(usage.resident, 2_MiB);
+    EXPECT_EQ(usage.peak_resident, 4_MiB);
+    EXPECT_EQ(usage.anonymous, 512_kiB);
+    EXPECT_EQ(usage.file_backed, 1500_kiB);
+    EXPECT_EQ(usage.shared_memory, 36_kiB);
+    EXPECT_EQ(usage.swap, 12_kiB);
+}
+
+TEST_F(FakeProcDirectory, ParsesStatm)
+{
+    const mu::process_memory::sampler sampler(directory);
+    EXPECT_EQ(sampler.resident(), mu::bytes(353 * mu::page_size().count()));
+}
+
+TEST_F(FakeProcDirectory, SamplesAgainWithoutReopening)
+{
+    const mu::process_memory::sampler sampler(directory);
+    EXPECT_EQ(sampler.snapshot().resident, 2_MiB);
+    write("status", "VmRSS:\t    3072 kB\n");
+    EXPECT_EQ(sampler.snapshot().resident, 3_MiB);
+    EXPECT_EQ(sampler.snapshot().peak_resident, 0_B);
+}
+
+TEST_F(FakeProcDirectory, SmapsRollup)
+{
+    EXPECT_THROW(static_cast<void>(mu::process_memory::sampler(directory).proportional_resident()), std::system_error);
+    write("smaps_rollup", "5647c83a5000-7ffd6c5ec000 ---p 00000000 00:00 0    [rollup]\n"
+                          "Rss:                1252 kB\n"
+                          "Pss:                 431 kB\n"
+                          "Pss_Dirty:           104 kB\n");
+    EXPECT_EQ(mu::process_memory::sampler(directory).proportional_resident(), 431_kiB);
+}
+
+TEST_F(FakeProcDirectory, FailsOnAFileLongerThanTheBuffer)
+{
+    const mu::process_memory::sampler sampler(directory);
+    write("status", std::string(8192, '#') + "\nVmRSS:\t    3072 kB\n");
+    EXPECT_THROW(static_cast<void>(sampler.snapshot()), std::system_error);
+    write("statm", std::string(256, ' ') + "660 353 327 5 0 123 0\n");
+    EXPECT_THROW(static_cast<void>(sampler.resident()), std::system_error);
+}
+
+TEST(ProcessMemory, MissingDirectory)
+{
+    EXPECT_THROW(mu::process_memory::sampler("/nonexistent/proc"), std::system_error);
+}
+
+TEST(ProcessMemory, SnapshotOfCurrentProcess)
+{
+    const auto before{mu::process_memory::snapshot()};
+    EXPECT_GT(before.resident, 0_B);
+    EXPECT_GE(before.peak_resident, before.resident);
+
+    std::vector<char> block(mu::memory_size_cast<mu::bytes>(64_MiB).count(), 1);
+    const auto after{mu::process_memory::snapshot()};
+    EXPECT_GE(after.resident, before.resident + 32_MiB);
+    EXPECT_GE(after.heap_arena, 64_MiB);
+    EXPECT_GE(mu::process_memory::sampler().resident(), 32_MiB);
+}
+#endif
@@ -0,0 +1,211 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <gtest/gtest.h>
+#include "memory_units_reclaimer.hpp"
+
+using namespace mu::literals;
+
+namespace
+{
+    // A cache that frees whole 1 MiB blocks.
+    struct fake_cache {
+        fake_cache(std::string name, const mu::bytes size, const int priority,
+                   const std::chrono::seconds age = std::chrono::seconds(0)) :
+            name(std::move(name)), size(size), priority(priority), age(age)
+        {
+        }
+
+        mu::reclaimer as_reclaimer()
+        {
+            return mu::reclaimer{name,
+                                 [this](const mu::bytes target) {
+                                     const auto block{mu::memory_size_cast<mu::bytes>(1_MiB)};
+                                     auto freed{mu::bytes::zero()};
+                                     while (freed < target && size >= block) {
+                                         size -= block;
+                                         freed += block;
+                                     }
+                                     return freed;
+                                 },
+                                 [this]() { return size; },
+                                 priority,
+                                 [this]() { return std::chrono::steady_clock::duration(age); }};
+        }
+
+        std::string name;
+        mu::bytes size;
+        int priority;
+        std::chrono::seconds age;
+    };
+} // namespace
+
+TEST(ReclaimerRegistry, RegisterAndRemove)
+{
+    mu::reclaimer_registry registry;
+    fake_cache first("first", mu::bytes(64_MiB), 0);
+    fake_cache second("second", mu::bytes(32_MiB), 0);
+    const auto first_id{registry.add(first.as_reclaimer())};
+    registry.add(second.as_reclaimer());
+    EXPECT_EQ(registry.size(), 2u);
+    EXPECT_EQ(registry.footprint(), 96_MiB);
+    EXPECT_TRUE(registry.remove(first_id));
+    EXPECT_FALSE(registry.remove(first_id));
+    EXPECT_EQ(registry.footprint(), 32_MiB);
+}
+
+TEST(ReclaimerRegistry, RemoveWaitsForAReclaimInProgress)
+{
+    mu::reclaimer_registry registry;
+    auto cache{std::make_unique<fake_cache>("cache", mu::bytes(64_MiB), 0)};
+    auto reclaim{cache->as_reclaimer()};
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool reclaiming{false};
+    bool released{false};
+    reclaim.reclaim = [&mutex, &condition, &reclaiming, &released, evict = reclaim.reclaim](const mu::bytes target) {
+        std::unique_lock<std::mutex> lock(mutex);
+        reclaiming = true;
+        condition.notify_all();
+        condition.wait(lock, [&released]() { return released; });
+        return evict(target);
+    };
+    const auto id{registry.add(std::move(reclaim))};
+
+    std::thread reclaimer([&registry]() { registry.reclaim(8_MiB, mu::reclaim_policy::priority); });
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [&reclaiming]() { return reclaiming; });
+    }
+    std::atomic<bool> removed{false};
+    std::thread remover([&]() {
+        EXPECT_TRUE(registry.remove(id));
+        removed = true;
+        // The cache unregisters in its destructor, and is never called again
+        cache.reset();
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(removed.load());
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        released = true;
+    }
+    condition.notify_all();
+    reclaimer.join();
+    remover.join();
+    EXPECT_TRUE(removed.load());
+    EXPECT_EQ(registry.size(), 0u);
+    EXPECT_EQ(registry.footprint(), 0_B);
+}
+
+TEST(ReclaimerRegistry, PriorityPolicy)
+{
+    mu::reclaimer_registry registry;
+    fake_cache important("important", mu::bytes(64_MiB), 10);
+    fake_cache small("small", mu::bytes(8_MiB), 0);
+    fake_cache large("large", mu::bytes(16_MiB), 0);
+    registry.add(important.as_reclaimer());
+    registry.add(small.as_reclaimer());
+    registry.add(large.as_reclaimer());
+
+    const auto report{registry.reclaim(30_MiB, mu::reclaim_policy::priority)};
+    EXPECT_EQ(report.requested, 30_MiB);
+    EXPECT_EQ(report.freed, 30_MiB);
+    EXPECT_EQ(large.size, 0_MiB);
+    EXPECT_EQ(small.size, 0_MiB);
+    EXPECT_EQ(important.size, 58_MiB);
+    ASSERT_EQ(report.components.size(), 3u);
+    EXPECT_EQ(report.components[0].name, "large");
+    EXPECT_EQ(report.components[2].name, "important");
+    EXPECT_EQ(report.components[2].requested, 6_MiB);
+}
+
+TEST(ReclaimerRegistry, ProportionalPolicy)
+{
+    mu::reclaimer_registry registry;
+    fake_cache first("first", mu::bytes(60_MiB), 0);
+    fake_cache second("second", mu::bytes(20_MiB), 0);
+    registry.add(first.as_reclaimer());
+    registry.add(second.as_reclaimer());
+
+    const auto report{registry.reclaim(40_MiB, mu::reclaim_policy::proportional)};
+    EXPECT_EQ(report.freed, 40_MiB);
+    EXPECT_EQ(first.size, 30_MiB);
+    EXPECT_EQ(second.size, 10_MiB);
+}
+
+TEST(ReclaimerRegistry, ProportionalPolicyCoversShortfall)
+{
+    mu::reclaimer_registry registry;
+    fake_cache cache("cache", mu::bytes(40_MiB), 0);
+    auto stubborn{cache.as_reclaimer()};
+    stubborn.name = "stubborn";
+    stubborn.reclaim = [](mu::bytes) { return mu::bytes::zero(); };
+    stubborn.footprint = []() { return mu::memory_size_cast<mu::bytes>(40_MiB); };
+    registry.add(cache.as_reclaimer());
+    registry.add(stubborn);
+
+    const auto report{registry.reclaim(20_MiB, mu::reclaim_policy::proportional)};
+    EXPECT_EQ(report.freed, 20_MiB);
+    EXPECT_EQ(cache.size, 20_MiB);
+}
+
+TEST(ReclaimerRegistry, LruAgePolicy)
+{
+    mu::reclaimer_registry registry;
+    fake_cache fresh("fresh", mu::bytes(32_MiB), 0, std::chrono::seconds(5));
+    fake_cache stale("stale", mu::bytes(32_MiB), 5, std::chrono::seconds(600));
+    registry.add(fresh.as_reclaimer());
+    registry.add(stale.as_reclaimer());
+
+    const auto report{registry.reclaim(40_MiB, mu::reclaim_policy::lru_age)};
+    EXPECT_EQ(report.freed, 40_MiB);
+    EXPECT_EQ(stale.size, 0_MiB);
+    EXPECT_EQ(fresh.size, 24_MiB);
+}
+
+TEST(ReclaimerRegistry, ThresholdAndPressure)
+{
+    mu::reclaimer_registry registry;
+    fake_cache cache("cache", mu::bytes(100_MiB), 0);
+    registry.add(cache.as_reclaimer());
+
+    EXPECT_EQ(registry.enforce(1_GiB, mu::reclaim_policy::priority).freed, 0_B);
+    EXPECT_EQ(registry.enforce(80_MiB, mu::reclaim_policy::priority).freed, 20_MiB);
+    EXPECT_EQ(cache.size, 80_MiB);
+    EXPECT_EQ(registry.relieve(0.25, mu::reclaim_policy::proportional).freed, 20_MiB);
+    EXPECT_EQ(cache.size, 60_MiB);
+}
+
+TEST(ReclaimerRegistry, NotEnoughToReclaim)
+{
+    mu::reclaimer_registry registry;
+    fake_cache cache("cache", mu::bytes(10_MiB), 0);
+    registry.add(cache.as_reclaimer());
+    const auto report{registry.reclaim(1_GiB, mu::reclaim_policy::priority)};
+    EXPECT_EQ(report.requested, 1_GiB);
+    EXPECT_EQ(report.freed, 10_MiB);
+}
@@ -0,0 +1,119 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+#include "memory_units.hpp"
+
+using namespace mu::literals;
+
+TEST(Rounding, FloorToCoarserUnits)
+{
+    static_assert(mu::floor<mu::mebibytes>(1536_kiB) == 1_MiB, "Rounded down");
+    EXPECT_EQ(mu::floor<mu::mebibytes>(1_MiB), 1_MiB);
+    EXPECT_EQ(mu::floor<mu::mebibytes>(1_MiB - 1_B), 0_MiB);
+    EXPECT_EQ(mu::floor<mu::kilobytes>(1_kiB), 1_kB);
+    EXPECT_EQ(mu::floor<mu::kibibytes>(2_kB), 1_kiB);
+}
+
+TEST(Rounding, CeilToCoarserUnits)
+{
+    static_assert(mu::ceil<mu::mebibytes>(1025_kiB) == 2_MiB, "Rounded up");
+    EXPECT_EQ(mu::ceil<mu::mebibytes>(1_MiB), 1_MiB);
+    EXPECT_EQ(mu::ceil<mu::mebibytes>(0_B), 0_MiB);
+    EXPECT_EQ(mu::ceil<mu::mebibytes>(1_B), 1_MiB);
+    EXPECT_EQ(mu::ceil<mu::kibibytes>(2_kB), 2_kiB);
+    EXPECT_EQ(mu::ceil<mu::gigabytes>(1_GiB), 2_GB);
+}
+
+TEST(Rounding, RoundsHalfToEven)
+{
+    static_assert(mu::round<mu::kilobytes>(2500_B) == 2_kB, "Halfway rounded to even");
+    EXPECT_EQ(mu::round<mu::kilobytes>(3500_B), 4_kB);
+    EXPECT_EQ(mu::round<mu::kilobytes>(2501_B), 3_kB);
+    EXPECT_EQ(mu::round<mu::kilobytes>(2499_B), 2_kB);
+    EXPECT_EQ(mu::round<mu::kibibytes>(512_B), 0_kiB);
+    EXPECT_EQ(mu::round<mu::kibibytes>(1536_B), 2_kiB);
+    EXPECT_EQ(mu::round<mu::gigabytes>(1_GiB), 1_GB);
+}
+
+TEST(Rounding, RoundsToFinerUnitsExactly)
+{
+    EXPECT_EQ(mu::floor<mu::bytes>(3_kiB), 3072_B);
+    EXPECT_EQ(mu::ceil<mu::bytes>(3_kiB), 3072_B);
+    EXPECT_EQ(mu::round<mu::kibibytes>(3_MiB), 3072_kiB);
+}
+
+TEST(Rounding, RoundsNegativeSizes)
+{
+    using signed_bytes = mu::memory_size<std::int64_t>;
+    using signed_kilobytes = mu::memory_size<std::int64_t, mu::details::kb>;
+    EXPECT_EQ(mu::floor<signed_kilobytes>(signed_bytes(-1500)).count(), -2);
+    EXPECT_EQ(mu::ceil<signed_kilobytes>(signed_bytes(-1500)).count(), -1);
+    EXPECT_EQ(mu::round<signed_kilobytes>(signed_bytes(-1500)).count(), -2);
+    EXPECT_EQ(mu::round<signed_kilobytes>(signed_bytes(-2500)).count(), -2);
+    EXPECT_EQ(mu::round<signed_kilobytes>(signed_bytes(-2501)).count(), -3);
+    EXPECT_EQ(mu::floor<signed_kilobytes>(signed_bytes(-2000)).count(), -2);
+    EXPECT_EQ(mu::abs(signed_bytes(-42)).count(), 42);
+    EXPECT_EQ(mu::abs(signed_bytes(42)).count(), 42);
+    EXPECT_EQ(mu::abs(42_kB), 42_kB);
+}
+
+TEST(Rounding, RoundsFloatingSizes)
+{
+    EXPECT_EQ(mu::floor<mu::gibibytes>(1.9_GiB), 1_GiB);
+    EXPECT_EQ(mu::ceil<mu::gibibytes>(1.1_GiB), 2_GiB);
+    EXPECT_EQ(mu::round<mu::gibibytes>(2.5_GiB), 2_GiB);
+    EXPECT_EQ(mu::round<mu::gibibytes>(3.5_GiB), 4_GiB);
+    EXPECT_EQ(mu::round<mu::megabytes>(mu::f_kilobytes(1499.9)), 1_MB);
+    EXPECT_DOUBLE_EQ(mu::floor<mu::f_mebibytes>(1536_kiB).count(), 1.5);
+    EXPECT_DOUBLE_EQ(mu::abs(mu::f_bytes(-2.5)).count(), 2.5);
+    static_assert(mu::floor<mu::bytes>(mu::f_bytes(2.75)) == 2_B, "Rounded at compile time");
+    EXPECT_EQ(mu::floor<mu::bytes>(mu::f_bytes(1.8e19)), mu::bytes(18000000000000000000u));
+}
+
+TEST(Rounding, RoundsNegativeFloatingSizes)
+{
+    using signed_kilobytes = mu::memory_size<std::int64_t, mu::details::kb>;
+    EXPECT_EQ(mu::floor<signed_kilobytes>(mu::f_bytes(-1500.0)).count(), -2);
+    EXPECT_EQ(mu::ceil<signed_kilobytes>(mu::f_bytes(-1500.0)).count(), -1);
+    EXPECT_EQ(mu::round<signed_kilobytes>(mu::f_bytes(-2500.0)).count(), -2);
+    EXPECT_EQ(mu::round<signed_kilobytes>(mu::f_bytes(-2500.5)).count(), -3);
+    EXPECT_EQ(mu::round<signed_kilobytes>(mu::f_bytes(-1500.0)).count(), -2);
+    EXPECT_EQ(mu::ceil<signed_kilobytes>(mu::f_bytes(-0.5)).count(), 0);
+    // Unsigned representations wrap like a negative integral count does
+    EXPECT_EQ(mu::floor<mu::bytes>(mu::f_bytes(-1.5)), mu::memory_size_cast<mu::bytes>(mu::memory_size<int>(-2)));
+    EXPECT_EQ(mu::ceil<mu::bytes>(mu::f_bytes(-0.5)), 0_B);
+}
+
+TEST(Rounding, RoundsRanges)
+{
+    const std::vector<mu::bytes> sizes{mu::bytes(0), mu::bytes(1), mu::bytes(512), mu::bytes(1024), mu::bytes(1536),
+                                       mu::bytes(2560)};
+    std::vector<mu::kibibytes> result(sizes.size());
+    mu::floor<mu::kibibytes>(sizes.begin(), sizes.end(), result.begin());
+    EXPECT_EQ(result, (std::vector<mu::kibibytes>{0_kiB, 0_kiB, 0_kiB, 1_kiB, 1_kiB, 2_kiB}));
+    mu::ceil<mu::kibibytes>(sizes.begin(), sizes.end(), result.begin());
+    EXPECT_EQ(result, (std::vector<mu::kibibytes>{0_kiB, 1_kiB, 1_kiB, 1_kiB, 2_kiB, 3_kiB}));
+    const auto end{mu::round<mu::kibibytes>(sizes.begin(), sizes.end(), result.begin())};
+    EXPECT_EQ(end, result.end());
+    EXPECT_EQ(result, (std::vector<mu::kibibytes>{0_kiB, 0_kiB, 0_kiB, 1_kiB, 2_kiB, 2_kiB}));
+}
@@ -0,0 +1,135 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include "memory_units_simd.hpp"
+
+using namespace mu::literals;
+
+namespace
+{
+    using lanes = mu::simd<std::uint64_t, 2>;
+    using f_lanes = mu::simd<double, 2>;
+    using kibibyte_lanes = mu::memory_size<lanes, mu::details::kib>;
+    using mebibyte_lanes = mu::memory_size<lanes, mu::details::mib>;
+} // namespace
+
+TEST(SimdRep, ArithmeticIsLaneWise)
+{
+    const kibibyte_lanes lhs{lanes(1, 2048)};
+    const mebibyte_lanes rhs{lanes(3, 4)};
+    const auto sum{lhs + rhs};
+    EXPECT_TRUE((std::is_same<decltype(sum), const kibibyte_lanes>::value));
+    EXPECT_EQ(sum.count()[0], 3073u);
+    EXPECT_EQ(sum.count()[1], 6144u);
+
+    const auto scaled{rhs * 2};
+    EXPECT_EQ(scaled.count()[1], 8u);
+    const auto ratio{rhs / lhs};
+    EXPECT_EQ(ratio[0], 3072u);
+    EXPECT_EQ(ratio[1], 2u);
+}
+
+TEST(SimdRep, BroadcastsScalarSizes)
+{
+    const auto shifted{mebibyte_lanes(lanes(1, 2)) + 512_kiB};
+    EXPECT_EQ(shifted.count()[0], 1536u);
+    EXPECT_EQ(shifted.count()[1], 2560u);
+}
+
+TEST(SimdRep, CastsEveryLane)
+{
+    const kibibyte_lanes sizes{lanes(1536, 3 * 1024 * 1024)};
+    const auto truncated{mu::memory_size_cast<mebibyte_lanes>(sizes)};
+    EXPECT_EQ(truncated.count()[0], 1u);
+    EXPECT_EQ(truncated.count()[1], 3072u);
+    const auto fractional{mu::memory_size_cast<mu::memory_size<f_lanes, mu::details::mib>>(sizes)};
+    EXPECT_DOUBLE_EQ(fractional.count()[0], 1.5);
+    const auto widened{mu::memory_size_cast<mu::memory_size<lanes>>(truncated)};
+    EXPECT_EQ(widened.count()[1], 3221225472u);
+}
+
+TEST(SimdRep, ComparisonsReturnMasks)
+{
+    const kibibyte_lanes lhs{lanes(1024, 4096)};
+    const mebibyte_lanes rhs{lanes(1, 1)};
+    const auto equal{lhs == rhs};
+    EXPECT_TRUE(equal[0]);
+    EXPECT_FALSE(equal[1]);
+    EXPECT_TRUE(mu::any_of(equal));
+    EXPECT_FALSE(mu::all_of(equal));
+    EXPECT_TRUE(mu::all_of(lhs >= rhs));
+    EXPECT_TRUE(mu::none_of(lhs < rhs));
+    EXPECT_TRUE(mu::all_of((lhs != rhs) || equal));
+
+    const auto largest{mu::select(lhs > rhs, lhs, kibibyte_lanes(rhs))};
+    EXPECT_EQ(largest.count()[0], 1024u);
+    EXPECT_EQ(largest.count()[1], 4096u);
+}
+
+TEST(SimdRep, LoadsAndStores)
+{
+    const std::uint64_t input[]{10, 20};
+    std::uint64_t output[2]{};
+    const kibibyte_lanes sizes{lanes::load(input)};
+    mu::memory_size_cast<mu::memory_size<lanes>>(sizes).count().store(output);
+    EXPECT_EQ(output[0], 10240u);
+    EXPECT_EQ(output[1], 20480u);
+}
+
+#if defined(MU_EXPERIMENTAL_SIMD)
+TEST(SimdRep, ConvertsWithTheParallelismTs)
+{
+    std::experimental::fixed_size_simd<std::uint64_t, 2> standard([](const auto lane) { return (lane + 1) * 10; });
+    const kibibyte_lanes sizes{lanes(standard)};
+    const auto converted{mu::memory_size_cast<mu::memory_size<lanes>>(sizes).count().to_experimental()};
+    EXPECT_EQ(converted[0], 10240u);
+    EXPECT_EQ(converted[1], 20480u);
+}
+
+TEST(SimdRep, UsesTheParallelismTsAsRepresentation)
+{
+    using standard_lanes = std::experimental::fixed_size_simd<std::uint64_t, 4>;
+    using standard_f_lanes = std::experimental::fixed_size_simd<double, 4>;
+    using kibibytes = mu::memory_size<standard_lanes, mu::details::kib>;
+    using mebibytes = mu::memory_size<standard_lanes, mu::details::mib>;
+    const kibibytes sizes{standard_lanes([](const auto lane) { return (lane + 1) * 1536; })};
+
+    const auto in_bytes{mu::memory_size_cast<mu::memory_size<standard_lanes>>(sizes)};
+    EXPECT_EQ(in_bytes.count()[3], 6291456u);
+    const auto truncated{mu::memory_size_cast<mebibytes>(sizes)};
+    EXPECT_EQ(truncated.count()[0], 1u);
+    EXPECT_EQ(truncated.count()[1], 3u);
+    const auto fractional{mu::memory_size_cast<mu::memory_size<standard_f_lanes, mu::details::mib>>(sizes)};
+    EXPECT_DOUBLE_EQ(fractional.count()[2], 4.5);
+
+    const auto sum{sizes + mebibytes(standard_lanes(1))};
+    EXPECT_TRUE((std::is_same<decltype(sum), const kibibytes>::value));
+    EXPECT_EQ(sum.count()[0], 2560u);
+    EXPECT_EQ((sizes * 2).count()[3], 12288u);
+
+    const auto large{sizes >= mebibytes(standard_lanes(3))};
+    EXPECT_FALSE(large[0]);
+    EXPECT_EQ(std::experimental::popcount(large), 3);
+    EXPECT_TRUE(std::experimental::all_of(sizes == in_bytes));
+    EXPECT_TRUE(std::experimental::none_of(sizes < truncated));
+}
+#endif
@@ -0,0 +1,161 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+#include "memory_units_quantile_sketch.hpp"
+
+using namespace mu::literals;
+
+namespace
+{
+    std::vector<mu::bytes> log_normal_sizes(const std::size_t count, const unsigned seed)
+    {
+        std::mt19937_64 engine(seed);
+        std::lognormal_distribution<double> distribution(8.0, 2.0);
+        std::vector<mu::bytes> sizes;
+        sizes.reserve(count);
+        for (std::size_t i{0}; i < count; ++i)
+            sizes.emplace_back(static_cast<std::uint64_t>(distribution(engine)));
+        return sizes;
+    }
+
+    double exact_quantile(std::vector<mu::bytes> sizes, const double q)
+    {
+        std::sort(sizes.begin(), sizes.end());
+        const auto rank{static_cast<std::size_t>(q * static_cast<double>(sizes.size() - 1))};
+        return static_cast<double>(sizes[rank].count());
+    }
+} // namespace
+
+TEST(SizeQuantileSketch, BudgetBoundsFootprint)
+{
+    const mu::size_quantile_sketch sketch(64_kiB);
+    EXPECT_LE(sketch.footprint(), 64_kiB);
+    EXPECT_GT(sketch.footprint(), 32_kiB);
+    EXPECT_THROW(mu::size_quantile_sketch(mu::bytes(64)), std::invalid_argument);
+}
+
+TEST(SizeQuantileSketch, EmptySketch)
+{
+    mu::size_quantile_sketch sketch(16_kiB);
+    EXPECT_TRUE(sketch.empty());
+    EXPECT_EQ(sketch.p50(), mu::bytes(0));
+    EXPECT_EQ(sketch.min(), mu::bytes(0));
+    EXPECT_EQ(sketch.max(), mu::bytes(0));
+}
+
+TEST(SizeQuantileSketch, SmallStreamsAreExact)
+{
+    mu::size_quantile_sketch sketch(16_kiB);
+    for (std::uint64_t i{1}; i <= 99; ++i)
+        sketch.insert(mu::kibibytes(i));
+
+    EXPECT_EQ(sketch.count(), 99u);
+    EXPECT_EQ(sketch.min(), 1_kiB);
+    EXPECT_EQ(sketch.max(), 99_kiB);
+    EXPECT_EQ(sketch.quantile(0.0), 1_kiB);
+    EXPECT_EQ(sketch.p50(), 50_kiB);
+    EXPECT_EQ(sketch.quantile(1.0), 99_kiB);
+}
+
+TEST(SizeQuantileSketch, TailAccuracy)
+{
+    const auto sizes{log_normal_sizes(200000, 42)};
+    mu::size_quantile_sketch sketch(32_kiB);
+    sketch.insert(sizes.begin(), sizes.end());
+
+    EXPECT_EQ(sketch.count(), sizes.size());
+    EXPECT_LE(sketch.footprint(), 32_kiB);
+    EXPECT_NEAR(static_cast<double>(sketch.p50().count()), exact_quantile(sizes, 0.5),
+                0.01 * exact_quantile(sizes, 0.5));
+    EXPECT_NEAR(static_cast<double>(sketch.p99().count()), exact_quantile(sizes, 0.99),
+                0.02 * exact_quantile(sizes, 0.99));
+    EXPECT_NEAR(static_cast<double>(sketch.p999().count()), exact_quantile(sizes, 0.999),
+                0.03 * exact_quantile(sizes, 0.999));
+}
+
+TEST(SizeQuantileSketch, Merge)
+{
+    const auto sizes{log_normal_sizes(100000, 7)};
+    mu::size_quantile_sketch whole(32_kiB);
+    mu::size_quantile_sketch left(32_kiB);
+    mu::size_quantile_sketch right(16_kiB);
+    whole.insert(sizes.begin(), sizes.end());
+    left.insert(sizes.begin(), sizes.begin() + 60000);
+    right.insert(sizes.begin() + 60000, sizes.end());
+    left.merge(right);
+
+    EXPECT_EQ(left.count(), whole.count());
+    EXPECT_EQ(left.min(), whole.min());
+    EXPECT_EQ(left.max(), whole.max());
+    EXPECT_LE(left.footprint(), 32_kiB);
+    EXPECT_NEAR(static_cast<double>(left.p50().count()), exact_quantile(sizes, 0.5),
+                0.02 * exact_quantile(sizes, 0.5));
+    EXPECT_NEAR(static_cast<double>(left.p99().count()), exact_quantile(sizes, 0.99),
+                0.03 * exact_quantile(sizes, 0.99));
+}
+
+TEST(SizeQuantileSketch, MergeWithItself)
+{
+    const auto sizes{log_normal_sizes(50000, 11)};
+    mu::size_quantile_sketch sketch(16_kiB);
+    sketch.insert(sizes.begin(), sizes.end());
+    sketch.insert(1_MiB);
+    const auto p50{static_cast<double>(sketch.p50().count())};
+    sketch.insert(2_MiB);
+    const auto smallest{sketch.min()};
+    const auto largest{sketch.max()};
+    sketch.merge(sketch);
+
+    EXPECT_EQ(sketch.count(), 2 * (sizes.size() + 2));
+    EXPECT_EQ(sketch.min(), smallest);
+    EXPECT_EQ(sketch.max(), largest);
+    EXPECT_LE(sketch.footprint(), 16_kiB);
+    EXPECT_NEAR(static_cast<double>(sketch.p50().count()), p50, 0.02 * p50);
+}
+
+TEST(SizeQuantileSketch, Clear)
+{
+    mu::size_quantile_sketch sketch(16_kiB);
+    sketch.insert(3_MiB);
+    sketch.insert(5_MiB);
+    sketch.clear();
+    EXPECT_TRUE(sketch.empty());
+    sketch.insert(7_MiB);
+    EXPECT_EQ(sketch.p50(), 7_MiB);
+}
+
+TEST(SizeQuantileSketch, LargestSizes)
+{
+    constexpr auto largest{std::numeric_limits<std::uint64_t>::max()};
+    mu::size_quantile_sketch sketch(16_kiB);
+    for (std::uint64_t i{0}; i < 1000; ++i)
+        sketch.insert(mu::bytes(largest - i * 4096));
+    EXPECT_EQ(sketch.quantile(1.0), mu::bytes(largest));
+    EXPECT_EQ(sketch.quantile(0.0), mu::bytes(largest - 999 * 4096));
+    const auto median{sketch.p50()};
+    EXPECT_GE(median, mu::bytes(largest - 999 * 4096));
+    EXPECT_LE(median, mu::bytes(largest));
+}
@@ -0,0 +1,101 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <numeric>
+#include <vector>
+#include "memory_units_size_vector.hpp"
+
+using namespace mu::literals;
+
+TEST(SizeVector, StoresRawCounts)
+{
+    mu::size_vector<mu::details::kib> sizes;
+    sizes.push_back(4_kiB);
+    sizes.push_back(2_MiB);
+    ASSERT_EQ(sizes.size(), 2u);
+    EXPECT_EQ(sizes[0], 4_kiB);
+    EXPECT_EQ(sizes.back(), 2048_kiB);
+    EXPECT_EQ(sizes.data()[1], 2048u);
+    sizes.set(0, 8_kiB);
+    EXPECT_EQ(sizes.front(), 8_kiB);
+    EXPECT_TRUE((std::is_same<decltype(sizes[0]), mu::kibibytes>::value));
+}
+
+TEST(SizeVector, StorageIsAligned)
+{
+    mu::size_vector<mu::details::b> sizes;
+    for (std::size_t count : {1u, 7u, 100u, 1000u}) {
+        sizes.resize(count);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(sizes.data()) % mu::size_vector<mu::details::b>::alignment, 0u);
+    }
+    EXPECT_GE(sizes.footprint(), mu::bytes(1000 * sizeof(std::uint64_t)));
+}
+
+TEST(SizeVector, AppendsRangesOfOtherUnits)
+{
+    const std::vector<mu::mebibytes> large{1_MiB, 3_MiB};
+    const std::list<mu::kibibytes> small{512_kiB, 1_kiB};
+    mu::size_vector<mu::details::kib> sizes(large.cbegin(), large.cend());
+    sizes.append(small.cbegin(), small.cend());
+    mu::size_vector<mu::details::b> in_bytes;
+    in_bytes.append(sizes);
+    ASSERT_EQ(in_bytes.size(), 4u);
+    EXPECT_EQ(std::vector<mu::bytes>(in_bytes.begin(), in_bytes.end()),
+              (std::vector<mu::bytes>{mu::bytes(1_MiB), mu::bytes(3_MiB), mu::bytes(512_kiB), mu::bytes(1_kiB)}));
+}
+
+TEST(SizeVector, AppendsItself)
+{
+    mu::size_vector<mu::details::kib> sizes;
+    sizes.push_back(1_kiB);
+    sizes.push_back(2_kiB);
+    sizes.append(sizes);
+    sizes.append(sizes.begin(), sizes.begin() + 3);
+    const auto view{sizes.view_as<mu::kibibytes>()};
+    sizes.append(view.begin(), view.end());
+    sizes.reserve(2 * sizes.size());
+    sizes.append(sizes);
+    const std::vector<mu::kibibytes> pattern{1_kiB, 2_kiB, 1_kiB, 2_kiB, 1_kiB, 2_kiB, 1_kiB};
+    ASSERT_EQ(sizes.size(), 4 * pattern.size());
+    for (std::size_t i{0}; i < sizes.size(); ++i)
+        EXPECT_EQ(sizes[i], pattern[i % pattern.size()]);
+}
+
+TEST(SizeVector, ViewsConvertLazily)
+{
+    mu::size_vector<mu::details::kib> sizes;
+    sizes.push_back(1_MiB);
+    sizes.push_back(1536_kiB);
+    const auto view{sizes.view_as<mu::f_mebibytes>()};
+    ASSERT_EQ(view.size(), 2u);
+    EXPECT_DOUBLE_EQ(view[1].count(), 1.5);
+    const auto truncated{sizes.view_as<mu::mebibytes>()};
+    EXPECT_EQ(std::vector<mu::mebibytes>(truncated.begin(), truncated.end()),
+              (std::vector<mu::mebibytes>{1_MiB, 1_MiB}));
+
+    sizes.set(0, 4_MiB);
+    EXPECT_DOUBLE_EQ(view[0].count(), 4.0);
+    EXPECT_DOUBLE_EQ(std::accumulate(view.begin(), view.end(), mu::f_mebibytes(0)).count(), 5.5);
+    EXPECT_EQ(std::max_element(truncated.begin(), truncated.end()) - truncated.begin(), 0);
+}
@@ -0,0 +1,161 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "memory_units_cache.hpp"
+#include "memory_units_reclaimer.hpp"
+
+using namespace mu::literals;
+
+namespace
+{
+    struct string_charge {
+        mu::bytes operator()(const int &, const std::string &value) const { return mu::bytes(value.size()); }
+    };
+
+    using string_cache = mu::sized_lru_cache<int, std::string, string_charge>;
+} // namespace
+
+TEST(SizedLruCache, CapacityIsSplitAmongShards)
+{
+    const string_cache cache(1_MiB, 8);
+    EXPECT_EQ(cache.shard_count(), 8u);
+    EXPECT_EQ(cache.capacity(), 1_MiB);
+    EXPECT_EQ(cache.usage(), 0_B);
+}
+
+TEST(SizedLruCache, PutAndGet)
+{
+    string_cache cache(1_kiB, 1);
+    EXPECT_TRUE(cache.put(1, std::string(100, 'a')));
+    EXPECT_TRUE(cache.put(2, std::string(200, 'b')));
+    EXPECT_EQ(cache.usage(), 300_B);
+
+    std::string value;
+    EXPECT_TRUE(cache.get(1, value));
+    EXPECT_EQ(value, std::string(100, 'a'));
+    EXPECT_FALSE(cache.get(3, value));
+
+    EXPECT_TRUE(cache.put(1, std::string(50, 'c')));
+    EXPECT_EQ(cache.usage(), 250_B);
+    EXPECT_TRUE(cache.erase(2));
+    EXPECT_FALSE(cache.erase(2));
+    EXPECT_EQ(cache.usage(), 50_B);
+}
+
+TEST(SizedLruCache, EvictsLeastRecentlyUsedBytes)
+{
+    string_cache cache(1_kiB, 1);
+    cache.put(1, std::string(400, 'a'));
+    cache.put(2, std::string(400, 'b'));
+    std::string value;
+    cache.get(1, value);
+    cache.put(3, std::string(400, 'c'));
+
+    EXPECT_TRUE(cache.contains(1));
+    EXPECT_FALSE(cache.contains(2));
+    EXPECT_TRUE(cache.contains(3));
+    EXPECT_LE(cache.usage(), 1_kiB);
+
+    const auto statistics{cache.statistics()};
+    EXPECT_EQ(statistics.entries, 2u);
+    EXPECT_EQ(statistics.evictions, 1u);
+    EXPECT_EQ(statistics.evicted, 400_B);
+}
+
+TEST(SizedLruCache, OneLargeEntryEvictsManySmallOnes)
+{
+    string_cache cache(1_kiB, 1);
+    for (int i{0}; i < 10; ++i)
+        cache.put(i, std::string(100, 'x'));
+    EXPECT_TRUE(cache.put(100, std::string(900, 'y')));
+    EXPECT_EQ(cache.statistics().entries, 2u);
+    EXPECT_TRUE(cache.contains(9));
+    EXPECT_FALSE(cache.put(200, std::string(2000, 'z')));
+    EXPECT_FALSE(cache.contains(200));
+}
+
+TEST(SizedLruCache, SieveKeepsVisitedEntries)
+{
+    string_cache cache(1_kiB, 1, mu::eviction_policy::sieve);
+    cache.put(1, std::string(300, 'a'));
+    cache.put(2, std::string(300, 'b'));
+    cache.put(3, std::string(300, 'c'));
+    std::string value;
+    EXPECT_TRUE(cache.get(1, value));
+    cache.put(4, std::string(300, 'd'));
+
+    EXPECT_TRUE(cache.contains(1));
+    EXPECT_FALSE(cache.contains(2));
+    EXPECT_TRUE(cache.contains(3));
+    EXPECT_TRUE(cache.contains(4));
+
+    cache.put(5, std::string(300, 'e'));
+    EXPECT_FALSE(cache.contains(3));
+    EXPECT_TRUE(cache.contains(1));
+}
+
+TEST(SizedLruCache, HitRate)
+{
+    mu::sized_lru_cache<int, int> cache(1_MiB);
+    cache.put(1, 10);
+    int value{0};
+    cache.get(1, value);
+    cache.get(1, value);
+    cache.get(1, value);
+    cache.get(2, value);
+    EXPECT_DOUBLE_EQ(cache.statistics().hit_rate(), 0.75);
+    EXPECT_EQ(cache.usage(), mu::bytes(2 * sizeof(int)));
+}
+
+TEST(SizedLruCache, ReclaimerIntegration)
+{
+    string_cache cache(1_MiB, 4);
+    for (int i{0}; i < 100; ++i)
+        cache.put(i, std::string(1000, 'x'));
+    mu::reclaimer_registry registry;
+    registry.add({"strings", [&cache](const mu::bytes target) { return cache.evict(target); },
+                  [&cache]() { return cache.usage(); }});
+    EXPECT_EQ(registry.enforce(mu::bytes(50000), mu::reclaim_policy::priority).freed, mu::bytes(50000));
+    EXPECT_EQ(cache.usage(), mu::bytes(50000));
+}
+
+TEST(SizedLruCache, ConcurrentAccess)
+{
+    for (const auto policy : {mu::eviction_policy::lru, mu::eviction_policy::sieve}) {
+        string_cache cache(64_kiB, 8, policy);
+        std::vector<std::thread> threads;
+        for (int t{0}; t < 4; ++t)
+            threads.emplace_back([&cache, t]() {
+                std::string value;
+                for (int i{0}; i < 20000; ++i) {
+                    const auto key{(i * 7 + t) % 2000};
+                    if (!cache.get(key, value))
+                        cache.put(key, std::string(static_cast<std::size_t>(key % 97 + 1), 'v'));
+                }
+            });
+        for (auto &thread : threads)
+            thread.join();
+        EXPECT_LE(cache.usage(), 64_kiB);
+        EXPECT_EQ(cache.statistics().hits + cache.statistics().misses, 80000u);
+    }
+}
@@ -0,0 +1,110 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <string>
+#include "memory_units_spillable_buffer.hpp"
+
+using namespace mu::literals;
+
+#if defined(__unix__)
+
+namespace
+{
+    std::string pattern(const std::size_t size, const char seed)
+    {
+        std::string text(size, '\0');
+        for (std::size_t i{0}; i < size; ++i)
+            text[i] = static_cast<char>(seed + i % 23);
+        return text;
+    }
+
+    std::string content_of(const mu::spillable_buffer &buffer)
+    {
+        const auto view{buffer.read()};
+        return std::string(view.begin(), view.end());
+    }
+} // namespace
+
+TEST(SpillableBuffer, StaysInMemoryUpToTheThreshold)
+{
+    mu::spillable_buffer buffer(1_kiB);
+    buffer.append(pattern(600, 'a'));
+    buffer.append(pattern(424, 'b'));
+    EXPECT_FALSE(buffer.spilled());
+    EXPECT_EQ(buffer.size(), 1_kiB);
+    EXPECT_LE(buffer.memory_footprint(), 1_kiB);
+    EXPECT_EQ(buffer.disk_footprint(), 0_B);
+    EXPECT_EQ(content_of(buffer), pattern(600, 'a') + pattern(424, 'b'));
+}
+
+TEST(SpillableBuffer, SpillsPastTheThreshold)
+{
+    mu::spillable_buffer buffer(1_kiB);
+    const auto first{pattern(1000, 'a')};
+    const auto second{pattern(100, 'b')};
+    buffer.append(first);
+    buffer.append(second);
+    EXPECT_TRUE(buffer.spilled());
+    EXPECT_EQ(buffer.size(), 1100_B);
+    EXPECT_EQ(buffer.disk_footprint(), 1000_B);
+    EXPECT_EQ(content_of(buffer), first + second);
+    EXPECT_EQ(buffer.disk_footprint(), 1100_B);
+}
+
+TEST(SpillableBuffer, KeepsAppendingAfterReads)
+{
+    mu::spillable_buffer buffer(0_B);
+    std::string expected;
+    for (int i{0}; i < 200; ++i) {
+        const auto chunk{pattern(static_cast<std::size_t>(97 * i % 5000), static_cast<char>('a' + i % 26))};
+        buffer.append(chunk);
+        expected += chunk;
+        if (i % 50 == 0) {
+            EXPECT_EQ(content_of(buffer), expected);
+        }
+    }
+    buffer.append(pattern(200000, 'z'));
+    expected += pattern(200000, 'z');
+    EXPECT_EQ(content_of(buffer), expected);
+    EXPECT_EQ(buffer.size(), mu::bytes(expected.size()));
+}
+
+TEST(SpillableBuffer, ClearGoesBackToMemory)
+{
+    mu::spillable_buffer buffer(16_B);
+    buffer.append(pattern(64, 'a'));
+    ASSERT_TRUE(buffer.spilled());
+    buffer.clear();
+    EXPECT_FALSE(buffer.spilled());
+    EXPECT_EQ(buffer.size(), 0_B);
+    EXPECT_TRUE(buffer.read().empty());
+    buffer.append(pattern(8, 'c'));
+    EXPECT_EQ(content_of(buffer), pattern(8, 'c'));
+}
+
+TEST(SpillableBuffer, ReportsUnusableDirectories)
+{
+    mu::spillable_buffer buffer(4_B, "/nonexistent");
+    buffer.append("abc", 3);
+    EXPECT_THROW(buffer.append("defg", 4), std::system_error);
+}
+
+#endif
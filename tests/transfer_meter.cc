@@ -0,0 +1,152 @@
+// Copyright (c) 2024 Papa Libasse Sow.
+// https://github.com/Nandite/Memory-Units
+// Distributed under the MIT Software License (X11 license).
+//
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+// the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "memory_units_transfer_meter.hpp"
+
+using namespace mu::literals;
+using namespace std::chrono_literals;
+
+TEST(TransferMeter, SumsTheAdditionsOfManyThreads)
+{
+    mu::transfer_meter meter(8_MiB);
+    std::vector<std::thread> threads;
+    for (int t{0}; t < 8; ++t)
+        threads.emplace_back([&meter]() {
+            for (int i{0}; i < 1024; ++i)
+                meter.add(1_kiB);
+        });
+    for (auto &thread : threads)
+        thread.join();
+    EXPECT_EQ(meter.transferred(), 8_MiB);
+    const auto snapshot{meter.snapshot()};
+    EXPECT_EQ(snapshot.transferred, 8_MiB);
+    EXPECT_EQ(snapshot.total, 8_MiB);
+    EXPECT_DOUBLE_EQ(snapshot.progress(), 1.0);
+    EXPECT_EQ(snapshot.eta, std::chrono::duration<double>::zero());
+}
+
+TEST(TransferMeter, MeasuresSteadyRates)
+{
+    const auto start{mu::transfer_meter::clock::now()};
+    mu::transfer_meter meter(100_MiB, 10s, 2s, start);
+    mu::transfer_snapshot snapshot{};
+    for (int second{1}; second <= 20; ++second) {
+        meter.add(1_MiB);
+        snapshot = meter.snapshot(start + std::chrono::seconds(second));
+    }
+    const mu::f_mebibytes_per_second expected(1.0);
+    EXPECT_NEAR(mu::rate_cast<mu::f_mebibytes_per_second>(snapshot.ewma_rate).count(), expected.count(), 1e-9);
+    EXPECT_NEAR(mu::rate_cast<mu::f_mebibytes_per_second>(snapshot.window_rate).count(), expected.count(), 1e-9);
+    EXPECT_NEAR(mu::rate_cast<mu::f_mebibytes_per_second>(snapshot.average_rate).count(), expected.count(), 1e-9);
+    EXPECT_NEAR(snapshot.eta.count(), 80.0, 1e-6);
+    EXPECT_DOUBLE_EQ(snapshot.progress(), 0.2);
+}
+
+TEST(TransferMeter, FollowsRateChanges)
+{
+    const auto start{mu::transfer_meter::clock::now()};
+    mu::transfer_meter meter(1_GiB, 4s, 1s, start);
+    for (int second{1}; second <= 10; ++second) {
+        meter.add(1_MiB);
+        meter.snapshot(start + std::chrono::seconds(second));
+    }
+    mu::transfer_snapshot snapshot{};
+    for (int second{11}; second <= 20; ++second) {
+        meter.add(4_MiB);
+        snapshot = meter.snapshot(start + std::chrono::seconds(second));
+    }
+    // The window only sees the new rate, the weighted average has mostly converged, the overall average lags.
+    const auto mebibytes_per_second = [](const mu::f_bytes_per_second rate) {
+        return mu::rate_cast<mu::f_mebibytes_per_second>(rate).count();
+    };
+    EXPECT_NEAR(mebibytes_per_second(snapshot.window_rate), 4.0, 1e-9);
+    EXPECT_NEAR(mebibytes_per_second(snapshot.ewma_rate), 4.0, 0.01);
+    EXPECT_NEAR(mebibytes_per_second(snapshot.average_rate), 2.5, 1e-9);
+}
+
+TEST(TransferMeter, SamplesAtMostOncePerInterval)
+{
+    const auto start{mu::transfer_meter::clock::now()};
+    mu::transfer_meter meter(1_GiB, 32s, 1s, start);
+    meter.add(1_MiB);
+    const auto first{meter.snapshot(start + 1s)};
+    meter.add(100_MiB);
+    const auto second{meter.snapshot(start + 1s + 500ms)};
+    EXPECT_EQ(second.transferred, 101_MiB);
+    EXPECT_EQ(second.ewma_rate.count(), first.ewma_rate.count());
+    EXPECT_GT(meter.snapshot(start + 2s).ewma_rate.count(), first.ewma_rate.count());
+}
+
+TEST(TransferMeter, IgnoresOutOfOrderSnapshots)
+{
+    const auto start{mu::transfer_meter::clock::now()};
+    mu::transfer_meter meter(1_GiB, 8s, 1s, start);
+    for (int second{1}; second <= 5; ++second) {
+        meter.add(1_MiB);
+        meter.snapshot(start + std::chrono::seconds(second));
+    }
+    const auto late{meter.snapshot(start + 2s)};
+    EXPECT_NEAR(mu::rate_cast<mu::f_mebibytes_per_second>(late.ewma_rate).count(), 1.0, 1e-9);
+    EXPECT_NEAR(mu::rate_cast<mu::f_mebibytes_per_second>(late.window_rate).count(), 1.0, 1e-9);
+
+    // Threads racing with timestamps out of order never produce a negative or wrapped rate
+    std::vector<std::thread> threads;
+    for (int thread{0}; thread < 4; ++thread) {
+        threads.emplace_back([&meter, start, thread] {
+            for (int i{0}; i < 2000; ++i) {
+                meter.add(1_kiB);
+                const auto snapshot{meter.snapshot(start + 5s + std::chrono::milliseconds(i * 4 - thread * 50))};
+                EXPECT_GE(snapshot.ewma_rate.count(), 0.0);
+                EXPECT_LT(mu::rate_cast<mu::f_mebibytes_per_second>(snapshot.ewma_rate).count(), 1024.0);
+                EXPECT_GE(snapshot.window_rate.count(), 0.0);
+                EXPECT_LT(mu::rate_cast<mu::f_mebibytes_per_second>(snapshot.window_rate).count(), 1024.0);
+            }
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+}
+
+TEST(TransferMeter, UnknownTotalsAndIdleTransfers)
+{
+    const auto start{mu::transfer_meter::clock::now()};
+    mu::transfer_meter meter(0_B, 10s, 1s, start);
+    const auto idle{meter.snapshot(start + 1s)};
+    EXPECT_EQ(idle.transferred, 0_B);
+    EXPECT_DOUBLE_EQ(idle.progress(), 0.0);
+    EXPECT_EQ(idle.ewma_rate.count(), 0.0);
+    EXPECT_EQ(idle.eta, std::chrono::duration<double>::max());
+
+    meter.add(1_MiB);
+    const auto moving{meter.snapshot(start + 2s)};
+    EXPECT_EQ(moving.transferred, 1_MiB);
+    EXPECT_EQ(moving.total, 0_B);
+    EXPECT_GT(moving.ewma_rate.count(), 0.0);
+    EXPECT_DOUBLE_EQ(moving.progress(), 0.0);
+    EXPECT_EQ(moving.eta, std::chrono::duration<double>::max());
+
+    mu::transfer_meter unsized;
+    EXPECT_EQ(unsized.snapshot().eta, std::chrono::duration<double>::max());
+    EXPECT_THROW(mu::transfer_meter(1_MiB, 0s), std::invalid_argument);
+}